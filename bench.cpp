@@ -0,0 +1,482 @@
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "my_allocators.h"
+#include "my_concurrent_vector.h"
+#include "my_segmented_vector.h"
+#include "my_sharded_vector.h"
+#include "my_vector.h"
+
+/*
+ * Бенчмарки my_vector::vector. Запуск без аргументов выполняет все замеры,
+ * иначе только те, чьё имя передано в аргументах.
+ */
+
+template <class Function>
+double measureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Пиковый RSS процесса в килобайтах
+long peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Выполняет function в дочернем процессе, чтобы пиковый RSS каждого замера
+// не зависел от предыдущих
+template <class Function>
+void runIsolated(Function&& function) {
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        function();
+        std::fflush(stdout);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        ++allocations;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend bool operator==(const CountingAllocator&,
+                           const CountingAllocator&) = default;
+
+    static inline std::size_t allocations = 0;
+};
+
+struct Record {
+    long key;
+    double values[5];
+};
+
+template <class GrowthPolicy>
+void benchGrowthPolicy(const char* name) {
+    runIsolated([name] {
+        constexpr std::size_t kCount = 5'000'000;
+        using allocator = CountingAllocator<Record>;
+        my_vector::vector<Record, allocator, GrowthPolicy> v;
+        allocator::allocations = 0;
+        double seconds = measureSeconds([&v] {
+            for (std::size_t i = 0; i < kCount; ++i) {
+                v.push_back(Record{static_cast<long>(i), {}});
+            }
+        });
+        std::printf(
+            "%-22s %8.1f Mops/s %4zu allocations %7ld MB peak RSS %5.1f%% "
+            "slack\n",
+            name, kCount / seconds / 1e6, allocator::allocations,
+            peakRssKb() / 1024,
+            100.0 * (v.capacity() - v.size()) / v.capacity());
+    });
+}
+
+void growthPolicies() {
+    std::printf("== push_back of 5M 48-byte records per growth policy ==\n");
+    benchGrowthPolicy<my_vector::doubling_growth>("doubling");
+    benchGrowthPolicy<my_vector::one_and_half_growth>("one_and_half");
+    benchGrowthPolicy<my_vector::page_rounded_growth<>>("page_rounded");
+    benchGrowthPolicy<my_vector::size_class_growth>("size_class");
+}
+
+void resizeLoop() {
+    std::printf("== repeated resize(size() + 16) of vector<int> ==\n");
+    for (std::size_t calls : {10'000, 100'000, 1'000'000, 4'000'000}) {
+        using allocator = CountingAllocator<int>;
+        my_vector::vector<int, allocator> v;
+        allocator::allocations = 0;
+        double seconds = measureSeconds([&v, calls] {
+            for (std::size_t i = 0; i < calls; ++i) {
+                v.resize(v.size() + 16);
+            }
+        });
+        std::printf("%9zu calls %8.2f ns/call %4zu allocations\n", calls,
+                    seconds / calls * 1e9, allocator::allocations);
+    }
+}
+
+template <class Vector>
+double shortLivedVectors(std::size_t iterations) {
+    std::size_t checksum = 0;
+    double seconds = measureSeconds([&checksum, iterations] {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            Vector v;
+            for (std::size_t j = 0; j < 6; ++j) {
+                v.push_back(i + j);
+            }
+            checksum += v.back();
+        }
+    });
+    if (checksum == 0) {
+        std::printf("unexpected checksum\n");
+    }
+    return seconds;
+}
+
+void smallVector() {
+    constexpr std::size_t kIterations = 10'000'000;
+    std::printf("== 10M short-lived vectors of 6 elements ==\n");
+    using heap = my_vector::vector<std::size_t>;
+    using small = my_vector::small_vector<std::size_t, 8>;
+    std::printf("vector          %8.1f ns/vector\n",
+                shortLivedVectors<heap>(kIterations) / kIterations * 1e9);
+    std::printf("small_vector<8> %8.1f ns/vector\n",
+                shortLivedVectors<small>(kIterations) / kIterations * 1e9);
+}
+
+template <class Vector>
+void benchGrowth(const char* name) {
+    runIsolated([name] {
+        constexpr std::size_t kCount = 10'000'000;
+        Vector v;
+        double seconds = measureSeconds([&v] {
+            for (std::size_t i = 0; i < kCount; ++i) {
+                v.push_back(Record{static_cast<long>(i), {}});
+            }
+        });
+        std::printf("%-16s %8.1f Mops/s %7ld MB peak RSS\n", name,
+                    kCount / seconds / 1e6, peakRssKb() / 1024);
+    });
+}
+
+void segmentedVector() {
+    std::printf("== push_back of 10M 48-byte records without reserve ==\n");
+    benchGrowth<my_vector::vector<Record>>("vector");
+    benchGrowth<my_vector::segmented_vector<Record>>("segmented_vector");
+}
+
+// threads потоков параллельно вызывают push(i) для своей доли из count
+// индексов
+template <class Push>
+double parallelPush(unsigned threads, std::size_t count, Push push) {
+    return measureSeconds([threads, count, &push] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([t, threads, count, &push] {
+                for (std::size_t i = t; i < count; i += threads) {
+                    push(i);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    });
+}
+
+void concurrentVector() {
+    constexpr std::size_t kCount = 8'000'000;
+    std::printf("== 8M concurrent push_backs of size_t ==\n");
+    unsigned max_threads = std::max(2u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        my_vector::vector<std::size_t> locked;
+        std::mutex mutex;
+        double locked_seconds = parallelPush(
+            threads, kCount, [&locked, &mutex](std::size_t i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.push_back(i);
+            });
+        my_vector::concurrent_vector<std::size_t> concurrent;
+        double concurrent_seconds = parallelPush(
+            threads, kCount,
+            [&concurrent](std::size_t i) { concurrent.push_back(i); });
+        std::printf(
+            "%3u threads: mutex + vector %7.1f Mops/s, concurrent_vector "
+            "%7.1f Mops/s\n",
+            threads, kCount / locked_seconds / 1e6,
+            kCount / concurrent_seconds / 1e6);
+    }
+}
+
+void shardedVector() {
+    constexpr std::size_t kCount = 8'000'000;
+    std::printf("== 8M parallel appends collected into one vector ==\n");
+    unsigned max_threads = std::max(2u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        my_vector::vector<std::size_t> locked;
+        std::mutex mutex;
+        double locked_seconds = parallelPush(
+            threads, kCount, [&locked, &mutex](std::size_t i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.push_back(i);
+            });
+        my_vector::sharded_vector<std::size_t> sharded(threads);
+        double sharded_seconds = parallelPush(
+            threads, kCount, [&sharded, threads](std::size_t i) {
+                sharded.shard(i % threads).push_back(i);
+            });
+        my_vector::vector<std::size_t> flat;
+        double flatten_seconds =
+            measureSeconds([&sharded, &flat] { flat = sharded.flatten(); });
+        std::printf(
+            "%3u threads: mutex + vector %7.1f Mops/s, sharded_vector "
+            "%7.1f Mops/s including %5.1f ms flatten\n",
+            threads, kCount / locked_seconds / 1e6,
+            kCount / (sharded_seconds + flatten_seconds) / 1e6,
+            flatten_seconds * 1e3);
+    }
+}
+
+template <class Construct>
+double measureConstruction(Construct construct) {
+    my_vector::vector<double> v;
+    double seconds = measureSeconds([&v, &construct] { v = construct(); });
+    return v[v.size() / 2] == 1.0 ? seconds : 0;
+}
+
+void parallelFill() {
+    constexpr std::size_t kCount = 32'000'000;
+    std::printf("== construction of 32M doubles filled with a value ==\n");
+    double serial = measureConstruction(
+        [] { return my_vector::vector<double>(kCount, 1.0); });
+    double parallel = measureConstruction([] {
+        return my_vector::vector<double>(my_vector::parallel, kCount, 1.0);
+    });
+    std::printf("serial %7.1f ms, parallel %7.1f ms (%u hardware threads)\n",
+                serial * 1e3, parallel * 1e3,
+                std::thread::hardware_concurrency());
+}
+
+// Пропускная способность (ГБ/с) чтения v потоками threads, каждый из
+// которых суммирует свою непрерывную часть, как при параллельном заполнении
+template <class Vector>
+double readBandwidth(const Vector& v, unsigned threads) {
+    constexpr int kPasses = 5;
+    std::vector<double> sums(threads);
+    double seconds = measureSeconds([&v, &sums, threads] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&v, &sums, t, threads] {
+                std::size_t begin = v.size() * t / threads;
+                std::size_t end = v.size() * (t + 1) / threads;
+                for (int pass = 0; pass < kPasses; ++pass) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        sums[t] += v[i];
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    });
+    double total = 0;
+    for (double sum : sums) {
+        total += sum;
+    }
+    if (total != static_cast<double>(v.size()) * kPasses) {
+        std::printf("unexpected sum\n");
+    }
+    return v.size() * sizeof(v[0]) * kPasses / seconds / 1e9;
+}
+
+void numaPlacement() {
+    using Allocator = my_vector::numa_allocator<double>;
+    constexpr std::size_t kCount = 32'000'000;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("== parallel read of 256 MB, %d NUMA nodes, %u threads ==\n",
+                Allocator::node_count(), threads);
+    {
+        my_vector::vector<double> v(kCount, 1.0);
+        std::printf("std::allocator, serial fill %7.1f GB/s\n",
+                    readBandwidth(v, threads));
+    }
+    {
+        my_vector::vector<double, Allocator> v(
+            my_vector::parallel, kCount, 1.0,
+            Allocator(my_vector::numa_placement::local));
+        std::printf("local, parallel fill        %7.1f GB/s\n",
+                    readBandwidth(v, threads));
+    }
+    {
+        my_vector::vector<double, Allocator> v(
+            my_vector::parallel, kCount, 1.0,
+            Allocator(my_vector::numa_placement::interleave));
+        std::printf("interleave                  %7.1f GB/s\n",
+                    readBandwidth(v, threads));
+    }
+}
+
+// Запрос строит несколько временных векторов разного размера без reserve
+template <class MakeVector>
+long scratchRequest(std::size_t request, MakeVector make_vector) {
+    long checksum = 0;
+    for (std::size_t j = 0; j < 8; ++j) {
+        auto v = make_vector();
+        std::size_t count = 64 << ((request + j) % 7);
+        for (std::size_t i = 0; i < count; ++i) {
+            v.push_back(static_cast<long>(i));
+        }
+        checksum += v.back();
+    }
+    return checksum;
+}
+
+void arenaRequests() {
+    using Allocator = my_vector::monotonic_allocator<long>;
+    constexpr std::size_t kRequests = 100'000;
+    std::printf("== 100K requests of 8 scratch vectors of 64..4096 longs ==\n");
+    long heap_checksum = 0;
+    double heap = measureSeconds([&heap_checksum] {
+        for (std::size_t r = 0; r < kRequests; ++r) {
+            heap_checksum += scratchRequest(
+                r, [] { return my_vector::vector<long>(); });
+        }
+    });
+    long arena_checksum = 0;
+    double arena = measureSeconds([&arena_checksum] {
+        my_vector::arena arena;
+        for (std::size_t r = 0; r < kRequests; ++r) {
+            arena_checksum += scratchRequest(r, [&arena] {
+                return my_vector::vector<long, Allocator>{Allocator(arena)};
+            });
+            arena.release();
+        }
+    });
+    std::printf("std::allocator      %7.1f us/request\n",
+                heap / kRequests * 1e6);
+    std::printf("monotonic_allocator %7.1f us/request%s\n",
+                arena / kRequests * 1e6,
+                heap_checksum == arena_checksum ? "" : " (mismatch)");
+}
+
+// Векторы близких размеров создаются и уничтожаются по очереди
+template <class Vector>
+double similarSizedVectors(std::size_t iterations) {
+    std::size_t checksum = 0;
+    double seconds = measureSeconds([&checksum, iterations] {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            Vector v;
+            v.reserve(1000 + i % 200);
+            v.push_back(i);
+            checksum += v.back();
+        }
+    });
+    if (checksum == 0) {
+        std::printf("unexpected checksum\n");
+    }
+    return seconds;
+}
+
+void recyclingPool() {
+    constexpr std::size_t kIterations = 10'000'000;
+    std::printf("== 10M short-lived vectors of ~1000 longs capacity ==\n");
+    using heap = my_vector::vector<long>;
+    using pooled = my_vector::vector<long, my_vector::pooled_allocator<long>>;
+    std::printf("std::allocator   %8.1f ns/vector\n",
+                similarSizedVectors<heap>(kIterations) / kIterations * 1e9);
+    std::printf("pooled_allocator %8.1f ns/vector\n",
+                similarSizedVectors<pooled>(kIterations) / kIterations * 1e9);
+}
+
+// Объём анонимной памяти процесса на больших страницах в мегабайтах
+long anonHugePagesMb() {
+    std::FILE* file = std::fopen("/proc/self/smaps_rollup", "r");
+    if (file == nullptr) {
+        return -1;
+    }
+    char line[256];
+    long kb = -1;
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        if (std::sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) {
+            break;
+        }
+    }
+    std::fclose(file);
+    return kb < 0 ? kb : kb / 1024;
+}
+
+template <class Vector>
+void benchRandomAccess(const char* name) {
+    runIsolated([name] {
+        constexpr std::size_t kCount = std::size_t{256} << 20;
+        constexpr std::size_t kReads = 50'000'000;
+        Vector v;
+        v.resize(kCount, 1.0f);
+        std::uint64_t state = 88172645463325252ull;
+        float sum = 0;
+        double seconds = measureSeconds([&v, &state, &sum] {
+            for (std::size_t i = 0; i < kReads; ++i) {
+                // xorshift64
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                sum += v[state % kCount];
+            }
+        });
+        std::printf("%-20s %6.1f ns/read %6ld MB on huge pages%s\n", name,
+                    seconds / kReads * 1e9, anonHugePagesMb(),
+                    sum > 0 ? "" : " (unexpected sum)");
+    });
+}
+
+void hugePages() {
+    std::printf("== 50M random reads from a 1 GB vector<float> ==\n");
+    benchRandomAccess<my_vector::vector<float>>("std::allocator");
+    benchRandomAccess<
+        my_vector::vector<float, my_vector::huge_page_allocator<float>,
+                          my_vector::huge_page_growth<>>>(
+        "huge_page_allocator");
+}
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+constexpr Benchmark kBenchmarks[] = {
+    {"growth_policies", growthPolicies},
+    {"resize_loop", resizeLoop},
+    {"small_vector", smallVector},
+    {"segmented_vector", segmentedVector},
+    {"concurrent_vector", concurrentVector},
+    {"sharded_vector", shardedVector},
+    {"parallel_fill", parallelFill},
+    {"numa_placement", numaPlacement},
+    {"arena_requests", arenaRequests},
+    {"recycling_pool", recyclingPool},
+    {"huge_pages", hugePages},
+};
+
+int main(int argc, char** argv) {
+    for (const Benchmark& benchmark : kBenchmarks) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i) {
+            selected = selected or std::strcmp(argv[i], benchmark.name) == 0;
+        }
+        if (selected) {
+            benchmark.run();
+        }
+    }
+}
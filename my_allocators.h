@@ -0,0 +1,824 @@
+/*
+ * Аллокаторы для my_vector::vector, использующие его необязательные
+ * расширения (см. expandable_allocator и reallocatable_allocator в
+ * my_vector.h)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include <linux/mempolicy.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "my_vector.h"
+
+namespace my_vector {
+
+/*
+ * Аллокатор поверх malloc/free. Изменение размера блока выполняется через
+ * realloc: glibc для больших блоков, выделенных через mmap, делает это
+ * вызовом mremap, то есть переотображением страниц без копирования.
+ */
+template <class T>
+class malloc_allocator {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "malloc does not guarantee over-aligned storage");
+
+    constexpr malloc_allocator() noexcept = default;
+
+    template <class U>
+    constexpr malloc_allocator(const malloc_allocator<U>&) noexcept {}
+
+    T* allocate(size_type n) {
+        void* ptr = std::malloc(bytes(n));
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    // malloc округляет запрос до своего размерного класса, весь блок
+    // доступен вызывающему
+    allocation_result<T*> allocate_at_least(size_type n) {
+        T* ptr = allocate(n);
+        return {ptr, malloc_usable_size(ptr) / sizeof(T)};
+    }
+
+    void deallocate(T* ptr, size_type) noexcept { std::free(ptr); }
+
+    // Блок уже вмещает new_n элементов, если malloc выделил его с запасом
+    bool try_expand(T* ptr, size_type, size_type new_n) const noexcept {
+        return new_n <= static_cast<size_type>(-1) / sizeof(T) and
+               malloc_usable_size(ptr) >= new_n * sizeof(T);
+    }
+
+    T* reallocate(T* ptr, size_type, size_type new_n) {
+        void* new_ptr = std::realloc(static_cast<void*>(ptr), bytes(new_n));
+        if (new_ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(new_ptr);
+    }
+
+    // realloc, как и malloc, округляет запрос до своего размерного класса
+    allocation_result<T*> reallocate_at_least(T* ptr, size_type n,
+                                              size_type new_n) {
+        T* new_ptr = reallocate(ptr, n, new_n);
+        return {new_ptr, malloc_usable_size(new_ptr) / sizeof(T)};
+    }
+
+    friend constexpr bool operator==(const malloc_allocator&,
+                                     const malloc_allocator&) noexcept {
+        return true;
+    }
+
+   private:
+    static size_type bytes(size_type n) {
+        if (n > static_cast<size_type>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+};
+
+namespace detail {
+
+// Маска узлов NUMA из /sys/devices/system/node/online (учитываются первые
+// 64 узла); 0, если сведений об узлах нет
+inline unsigned long online_numa_nodes() {
+    static const unsigned long nodes = [] {
+        constexpr unsigned max_nodes =
+            std::numeric_limits<unsigned long>::digits;
+        unsigned long mask = 0;
+        std::FILE* file = std::fopen("/sys/devices/system/node/online", "r");
+        if (file == nullptr) {
+            return mask;
+        }
+        // формат списка: "0-3,5"
+        unsigned first = 0;
+        while (std::fscanf(file, "%u", &first) == 1) {
+            unsigned last = first;
+            int separator = std::fgetc(file);
+            if (separator == '-') {
+                if (std::fscanf(file, "%u", &last) != 1) {
+                    break;
+                }
+                separator = std::fgetc(file);
+            }
+            for (unsigned node = first; node <= last and node < max_nodes;
+                 ++node) {
+                mask |= 1ul << node;
+            }
+            if (separator != ',') {
+                break;
+            }
+        }
+        std::fclose(file);
+        return mask;
+    }();
+    return nodes;
+}
+
+}  // namespace detail
+
+// Размещение страниц блока по узлам NUMA
+enum class numa_placement {
+    local,       // на узле потока, первым коснувшегося страницы
+    interleave,  // по очереди на всех узлах
+    bind,        // только на заданном узле
+};
+
+/*
+ * Аллокатор, выделяющий каждый блок отдельным отображением mmap и задающий
+ * для него политику NUMA вызовом mbind(2) (без зависимости от libnuma).
+ * На машине с одним узлом политика не задаётся, а если ядро отказывает в
+ * mbind, память размещается по политике процесса. Каждый блок занимает
+ * целое число страниц, поэтому аллокатор рассчитан на большие векторы.
+ *
+ * Политика local размещает страницу на узле потока, первым к ней
+ * обратившегося: заполнение и перенос с тегом my_vector::parallel касаются
+ * каждой части вектора из обрабатывающего её потока.
+ *
+ * Ёмкость меняется через mremap без копирования, политика сохраняется за
+ * отображением.
+ */
+template <class T>
+class numa_allocator {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    // munmap освобождает блок независимо от политики выделившего аллокатора
+    using is_always_equal = std::true_type;
+
+    constexpr numa_allocator() noexcept = default;
+
+    constexpr explicit numa_allocator(numa_placement placement,
+                                      int node = 0) noexcept
+        : placement_(placement), node_(node) {}
+
+    template <class U>
+    constexpr numa_allocator(const numa_allocator<U>& other) noexcept
+        : placement_(other.placement()), node_(other.node()) {}
+
+    constexpr numa_placement placement() const noexcept { return placement_; }
+
+    constexpr int node() const noexcept { return node_; }
+
+    // Число узлов NUMA; 1, если сведений о них нет
+    static int node_count() {
+        return std::max(1, std::popcount(detail::online_numa_nodes()));
+    }
+
+    T* allocate(size_type n) { return allocate_at_least(n).ptr; }
+
+    // Блок округляется до целого числа страниц. Отображение нулевой длины
+    // невозможно, пустой запрос получает nullptr
+    allocation_result<T*> allocate_at_least(size_type n) {
+        if (n == 0) {
+            return {nullptr, 0};
+        }
+        size_type length = pageBytes(bytes(n));
+        void* ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        applyPolicy(ptr, length);
+        // при sizeof(T) больше страницы по округлённому числу элементов
+        // нельзя восстановить длину отображения
+        size_type count = length / sizeof(T);
+        if (pageBytes(count * sizeof(T)) != length) {
+            count = n;
+        }
+        return {static_cast<T*>(ptr), count};
+    }
+
+    void deallocate(T* ptr, size_type n) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        munmap(ptr, pageBytes(n * sizeof(T)));
+    }
+
+    // Расширяет отображение, если за ним свободно адресное пространство
+    bool try_expand(T* ptr, size_type n, size_type new_n) const noexcept {
+        if (ptr == nullptr) {
+            return new_n == 0;
+        }
+        size_type length = pageBytes(n * sizeof(T));
+        size_type new_length = pageBytes(new_n * sizeof(T));
+        return new_length <= length or
+               mremap(ptr, length, new_length, 0) != MAP_FAILED;
+    }
+
+    // Переотображает страницы на новое место без копирования
+    T* reallocate(T* ptr, size_type n, size_type new_n) {
+        if (ptr == nullptr) {
+            return allocate(new_n);
+        }
+        if (new_n == 0) {
+            deallocate(ptr, n);
+            return nullptr;
+        }
+        void* new_ptr = mremap(ptr, pageBytes(n * sizeof(T)),
+                               pageBytes(bytes(new_n)), MREMAP_MAYMOVE);
+        if (new_ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(new_ptr);
+    }
+
+    friend constexpr bool operator==(const numa_allocator&,
+                                     const numa_allocator&) noexcept {
+        return true;
+    }
+
+   private:
+    numa_placement placement_ = numa_placement::local;
+    int node_ = 0;
+
+    static size_type bytes(size_type n) {
+        if (n > static_cast<size_type>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+    static size_type pageBytes(size_type bytes) noexcept {
+        static const size_type page = sysconf(_SC_PAGESIZE);
+        return (bytes + page - 1) / page * page;
+    }
+
+    // Отказ mbind (нет поддержки в ядре, несуществующий узел) оставляет
+    // политику процесса
+    void applyPolicy(void* ptr, size_type length) const noexcept {
+        unsigned long nodes = detail::online_numa_nodes();
+        if (std::popcount(nodes) < 2) {
+            return;
+        }
+        constexpr int bits = std::numeric_limits<unsigned long>::digits;
+        int mode = MPOL_LOCAL;
+        unsigned long mask = 0;
+        if (placement_ == numa_placement::interleave) {
+            mode = MPOL_INTERLEAVE;
+            mask = nodes;
+        } else if (placement_ == numa_placement::bind) {
+            mode = MPOL_BIND;
+            mask = node_ >= 0 and node_ < bits ? 1ul << node_ : 0;
+        }
+        // ядро отбрасывает последний бит maxnode, как и в libnuma
+        syscall(SYS_mbind, ptr, length, mode, mask == 0 ? nullptr : &mask,
+                mask == 0 ? 0 : bits + 1, 0);
+    }
+};
+
+/*
+ * Монотонная арена: память выдаётся сдвигом указателя внутри крупных
+ * блоков и освобождается вся сразу вызовом release или деструктором.
+ * Последнее выделение можно расширить или вернуть, пока за ним ничего не
+ * выделено, поэтому растущий вектор, выделивший память последним,
+ * увеличивается на месте без копирования.
+ *
+ * Арена не потокобезопасна и рассчитана на короткоживущие данные одного
+ * запроса.
+ */
+class arena {
+   public:
+    explicit arena(std::size_t initial_block = 64 * 1024)
+        : next_block_(std::max(initial_block, sizeof(Block))) {}
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() {
+        release();
+        freeBlock(blocks_);
+        blocks_ = nullptr;
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        // пустое выделение тоже занимает байт: иначе следующее получило бы
+        // тот же адрес, и расширение пустого блока на месте затёрло бы его
+        bytes = std::max<std::size_t>(bytes, 1);
+        std::byte* ptr = aligned(cursor_, alignment);
+        if (blocks_ == nullptr or ptr > end_ or
+            static_cast<std::size_t>(end_ - ptr) < bytes) {
+            addBlock(bytes + alignment);
+            ptr = aligned(cursor_, alignment);
+        }
+        last_ = ptr;
+        cursor_ = ptr + bytes;
+        return ptr;
+    }
+
+    // Возвращает память, только если это последнее выделение
+    void deallocate(void* ptr, std::size_t) noexcept {
+        if (ptr != nullptr and ptr == last_) {
+            cursor_ = last_;
+            last_ = nullptr;
+        }
+    }
+
+    // Расширяет последнее выделение до new_bytes, если в блоке есть место
+    bool try_expand(void* ptr, std::size_t, std::size_t new_bytes) noexcept {
+        if (ptr == nullptr or ptr != last_ or
+            static_cast<std::size_t>(end_ - last_) < new_bytes) {
+            return false;
+        }
+        cursor_ = last_ + new_bytes;
+        return true;
+    }
+
+    /*
+     * Освобождает все выделения. Самый большой блок (последний
+     * добавленный) сохраняется для следующих запросов, чтобы повторное
+     * использование арены не обращалось к куче
+     */
+    void release() noexcept {
+        if (blocks_ == nullptr) {
+            return;
+        }
+        while (blocks_->previous != nullptr) {
+            Block* previous = blocks_->previous;
+            blocks_->previous = previous->previous;
+            freeBlock(previous);
+        }
+        cursor_ = reinterpret_cast<std::byte*>(blocks_ + 1);
+        last_ = nullptr;
+    }
+
+   private:
+    struct Block {
+        Block* previous;
+        std::size_t size;
+    };
+
+    Block* blocks_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* end_ = nullptr;
+    std::byte* last_ = nullptr;
+    std::size_t next_block_;
+
+    static std::byte* aligned(std::byte* ptr, std::size_t alignment) {
+        auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return ptr + ((alignment - address % alignment) % alignment);
+    }
+
+    // Размеры блоков растут вдвое, чтобы число обращений к куче было
+    // логарифмическим от объёма запроса
+    void addBlock(std::size_t bytes) {
+        std::size_t size = std::max(next_block_, sizeof(Block) + bytes);
+        auto* block = static_cast<Block*>(::operator new(size));
+        block->previous = blocks_;
+        block->size = size;
+        blocks_ = block;
+        cursor_ = reinterpret_cast<std::byte*>(block + 1);
+        end_ = reinterpret_cast<std::byte*>(block) + size;
+        last_ = nullptr;
+        next_block_ = size * 2;
+    }
+
+    static void freeBlock(Block* block) noexcept {
+        if (block != nullptr) {
+            ::operator delete(block, block->size);
+        }
+    }
+};
+
+/*
+ * Аллокатор поверх arena. Копии аллокатора ссылаются на ту же арену, при
+ * присваивании контейнеров аллокатор не распространяется: элементы
+ * переносятся в память арены контейнера-получателя.
+ */
+template <class T>
+class monotonic_allocator {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    explicit monotonic_allocator(arena& resource) noexcept
+        : arena_(&resource) {}
+
+    template <class U>
+    monotonic_allocator(const monotonic_allocator<U>& other) noexcept
+        : arena_(other.resource()) {}
+
+    arena* resource() const noexcept { return arena_; }
+
+    T* allocate(size_type n) {
+        if (n > static_cast<size_type>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_type n) noexcept {
+        arena_->deallocate(ptr, n * sizeof(T));
+    }
+
+    bool try_expand(T* ptr, size_type n, size_type new_n) noexcept {
+        return new_n <= static_cast<size_type>(-1) / sizeof(T) and
+               arena_->try_expand(ptr, n * sizeof(T), new_n * sizeof(T));
+    }
+
+    template <class U>
+    friend bool operator==(const monotonic_allocator& lhs,
+                           const monotonic_allocator<U>& rhs) noexcept {
+        return lhs.resource() == rhs.resource();
+    }
+
+   private:
+    arena* arena_;
+};
+
+/*
+ * Пул буферов одного потока: освобождённые блоки не возвращаются в кучу, а
+ * складываются в списки по классам размера (степени двойки от min_block до
+ * max_block байт) и выдаются следующим запросам того же класса. Блоки
+ * больших размеров проходят мимо пула.
+ *
+ * Объём хранимых блоков ограничен max_cached_bytes на поток и
+ * max_blocks_per_class на класс, лишние блоки освобождаются сразу. Блок,
+ * выделенный в одном потоке, можно вернуть в пул другого.
+ */
+class buffer_pool {
+   public:
+    struct statistics {
+        std::size_t hits = 0;       // запросы, выданные из пула
+        std::size_t misses = 0;     // запросы, ушедшие в кучу
+        std::size_t recycled = 0;   // блоки, принятые в пул
+        std::size_t dropped = 0;    // блоки, освобождённые из-за лимитов
+        std::size_t cached_bytes = 0;
+    };
+
+    static constexpr std::size_t min_block = 64;
+    static constexpr std::size_t max_block = std::size_t{1} << 20;
+    static constexpr std::size_t max_blocks_per_class = 64;
+
+    buffer_pool() = default;
+
+    buffer_pool(const buffer_pool&) = delete;
+    buffer_pool& operator=(const buffer_pool&) = delete;
+
+    ~buffer_pool() {
+        trim();
+        if (this == local_) {
+            local_ = nullptr;
+            local_destroyed_ = true;
+        }
+    }
+
+    // Пул текущего потока; nullptr, если поток уже завершается и пул
+    // уничтожен
+    static buffer_pool* local() noexcept {
+        if (local_ == nullptr and not local_destroyed_) {
+            thread_local buffer_pool pool;
+            local_ = &pool;
+        }
+        return local_;
+    }
+
+    // Размер блока, который выделяется под bytes байт
+    static std::size_t block_size(std::size_t bytes) noexcept {
+        return bytes > max_block ? bytes
+                                 : std::bit_ceil(std::max(bytes, min_block));
+    }
+
+    void* allocate(std::size_t bytes) {
+        std::size_t size = block_size(bytes);
+        if (size <= max_block) {
+            std::size_t index = classOf(size);
+            if (FreeBlock* block = free_[index]) {
+                free_[index] = block->next;
+                --counts_[index];
+                stats_.cached_bytes -= size;
+                ++stats_.hits;
+                return block;
+            }
+        }
+        ++stats_.misses;
+        return ::operator new(size);
+    }
+
+    void deallocate(void* ptr, std::size_t bytes) noexcept {
+        std::size_t size = block_size(bytes);
+        if (size <= max_block) {
+            std::size_t index = classOf(size);
+            if (counts_[index] < max_blocks_per_class and
+                stats_.cached_bytes + size <= max_cached_bytes_) {
+                free_[index] = ::new (ptr) FreeBlock{free_[index]};
+                ++counts_[index];
+                stats_.cached_bytes += size;
+                ++stats_.recycled;
+                return;
+            }
+            ++stats_.dropped;
+        }
+        ::operator delete(ptr, size);
+    }
+
+    // Ограничение суммарного объёма хранимых блоков; лишние освобождаются
+    void set_max_cached_bytes(std::size_t bytes) noexcept {
+        max_cached_bytes_ = bytes;
+        if (stats_.cached_bytes > bytes) {
+            trim();
+        }
+    }
+
+    std::size_t max_cached_bytes() const noexcept { return max_cached_bytes_; }
+
+    const statistics& stats() const noexcept { return stats_; }
+
+    // Возвращает все хранимые блоки в кучу
+    void trim() noexcept {
+        for (std::size_t index = 0; index < classes; ++index) {
+            std::size_t size = min_block << index;
+            while (FreeBlock* block = free_[index]) {
+                free_[index] = block->next;
+                ::operator delete(block, size);
+            }
+            counts_[index] = 0;
+        }
+        stats_.cached_bytes = 0;
+    }
+
+   private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr std::size_t classes =
+        std::countr_zero(max_block) - std::countr_zero(min_block) + 1;
+
+    static inline thread_local buffer_pool* local_ = nullptr;
+    static inline thread_local bool local_destroyed_ = false;
+
+    FreeBlock* free_[classes]{};
+    std::size_t counts_[classes]{};
+    std::size_t max_cached_bytes_ = 4 * max_block;
+    statistics stats_;
+
+    static std::size_t classOf(std::size_t size) noexcept {
+        return std::countr_zero(size) - std::countr_zero(min_block);
+    }
+};
+
+/*
+ * Аллокатор, берущий память из buffer_pool текущего потока. Ёмкость
+ * вектора округляется до класса размера блока, поэтому векторы близких
+ * размеров повторно используют одни и те же буферы. После завершения
+ * потока память выделяется и освобождается напрямую в куче.
+ */
+template <class T>
+class pooled_allocator {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "operator new does not guarantee over-aligned storage");
+
+    constexpr pooled_allocator() noexcept = default;
+
+    template <class U>
+    constexpr pooled_allocator(const pooled_allocator<U>&) noexcept {}
+
+    T* allocate(size_type n) { return allocate_at_least(n).ptr; }
+
+    allocation_result<T*> allocate_at_least(size_type n) {
+        if (n > static_cast<size_type>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        std::size_t size = buffer_pool::block_size(n * sizeof(T));
+        buffer_pool* pool = buffer_pool::local();
+        void* ptr = pool != nullptr ? pool->allocate(size)
+                                    : ::operator new(size);
+        return {static_cast<T*>(ptr), size / sizeof(T)};
+    }
+
+    void deallocate(T* ptr, size_type n) noexcept {
+        if (buffer_pool* pool = buffer_pool::local()) {
+            pool->deallocate(ptr, n * sizeof(T));
+        } else {
+            ::operator delete(ptr, buffer_pool::block_size(n * sizeof(T)));
+        }
+    }
+
+    friend constexpr bool operator==(const pooled_allocator&,
+                                     const pooled_allocator&) noexcept {
+        return true;
+    }
+};
+
+/*
+ * Аллокатор для больших векторов на прозрачных больших страницах (THP).
+ * Блоки от huge_page_size байт отображаются через mmap с выравниванием по
+ * huge_page_size и помечаются madvise(MADV_HUGEPAGE), так что ядро может
+ * покрыть их страницами по 2 МБ и сократить промахи TLB. Если THP
+ * отключены или madvise не поддерживается, блок остаётся на обычных
+ * страницах. Меньшие блоки выделяются через operator new.
+ *
+ * Вместе с huge_page_growth ёмкость больших векторов кратна большой
+ * странице, и блоки не заканчиваются частично заполненной страницей.
+ */
+template <class T>
+class huge_page_allocator {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "operator new does not guarantee over-aligned storage");
+
+    constexpr huge_page_allocator() noexcept = default;
+
+    template <class U>
+    constexpr huge_page_allocator(const huge_page_allocator<U>&) noexcept {}
+
+    T* allocate(size_type n) { return allocate_at_least(n).ptr; }
+
+    // Отображённый блок округляется до целого числа больших страниц
+    allocation_result<T*> allocate_at_least(size_type n) {
+        size_type bytes = byteCount(n);
+        if (bytes < huge_page_size) {
+            return {static_cast<T*>(::operator new(bytes)), n};
+        }
+        size_type length = hugeBytes(bytes);
+        // с запасом в одну большую страницу, чтобы вырезать выровненный
+        // участок
+        void* mapping = mmap(nullptr, length + huge_page_size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        auto* start = static_cast<std::byte*>(mapping);
+        auto address = reinterpret_cast<std::uintptr_t>(start);
+        std::size_t head = (huge_page_size - address % huge_page_size) %
+                           huge_page_size;
+        if (head != 0) {
+            munmap(start, head);
+        }
+        munmap(start + head + length, huge_page_size - head);
+        madvise(start + head, length, MADV_HUGEPAGE);
+
+        size_type count = length / sizeof(T);
+        if (hugeBytes(count * sizeof(T)) != length) {
+            count = n;
+        }
+        return {reinterpret_cast<T*>(start + head), count};
+    }
+
+    void deallocate(T* ptr, size_type n) noexcept {
+        size_type bytes = n * sizeof(T);
+        if (bytes < huge_page_size) {
+            ::operator delete(ptr, bytes);
+        } else {
+            munmap(ptr, hugeBytes(bytes));
+        }
+    }
+
+    // Расширяет отображение на месте, если за ним свободно адресное
+    // пространство; выравнивание блока при этом сохраняется
+    bool try_expand(T* ptr, size_type n, size_type new_n) const noexcept {
+        size_type bytes = n * sizeof(T);
+        if (bytes < huge_page_size or
+            new_n > static_cast<size_type>(-1) / sizeof(T)) {
+            return false;
+        }
+        size_type length = hugeBytes(bytes);
+        size_type new_length = hugeBytes(new_n * sizeof(T));
+        if (new_length <= length) {
+            return true;
+        }
+        if (mremap(ptr, length, new_length, 0) == MAP_FAILED) {
+            return false;
+        }
+        madvise(reinterpret_cast<std::byte*>(ptr) + length,
+                new_length - length, MADV_HUGEPAGE);
+        return true;
+    }
+
+    friend constexpr bool operator==(const huge_page_allocator&,
+                                     const huge_page_allocator&) noexcept {
+        return true;
+    }
+
+   private:
+    static size_type byteCount(size_type n) {
+        // запас на округление и выравнивание отображения
+        if (n > (static_cast<size_type>(-1) - 2 * huge_page_size) /
+                    sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+    static size_type hugeBytes(size_type bytes) noexcept {
+        return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+};
+
+/*
+ * Аллокатор с выравниванием блоков по Alignment байт (по умолчанию строка
+ * кэша и ширина регистра AVX-512), так что data() вектора выровнен для
+ * выровненных SIMD-загрузок. При PadCapacity размер блока округляется до
+ * кратного Alignment, и через allocate_at_least вектор получает ёмкость,
+ * кратную ширине SIMD-регистра: ядра могут обрабатывать данные целыми
+ * регистрами до padded_size(size()) без цикла для остатка.
+ */
+template <class T, std::size_t Alignment = 64, bool PadCapacity = true>
+class aligned_allocator {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    static_assert(std::has_single_bit(Alignment),
+                  "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(T),
+                  "Alignment must not be weaker than alignof(T)");
+
+    // allocator_traits не умеет подменять тип в шаблонах с параметрами-
+    // значениями
+    template <class U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment, PadCapacity>;
+    };
+
+    static constexpr std::size_t alignment = Alignment;
+
+    constexpr aligned_allocator() noexcept = default;
+
+    template <class U>
+    constexpr aligned_allocator(
+        const aligned_allocator<U, Alignment, PadCapacity>&) noexcept {}
+
+    // Число элементов, помещающихся в n элементов, округлённые вверх до
+    // кратного Alignment числа байт; ёмкость вектора при PadCapacity
+    static constexpr size_type padded_size(size_type n) noexcept {
+        return ((n * sizeof(T) + Alignment - 1) & ~(Alignment - 1)) /
+               sizeof(T);
+    }
+
+    T* allocate(size_type n) { return allocate_at_least(n).ptr; }
+
+    allocation_result<T*> allocate_at_least(size_type n) {
+        if (n > (static_cast<size_type>(-1) - Alignment) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        size_type count = PadCapacity ? padded_size(n) : n;
+        void* ptr = ::operator new(count * sizeof(T),
+                                   std::align_val_t{Alignment});
+        return {static_cast<T*>(ptr), count};
+    }
+
+    // n может быть как запрошенным, так и полученным из allocate_at_least
+    // числом элементов: padded_size от обоих одинаков
+    void deallocate(T* ptr, size_type n) noexcept {
+        size_type count = PadCapacity ? padded_size(n) : n;
+        ::operator delete(ptr, count * sizeof(T),
+                          std::align_val_t{Alignment});
+    }
+
+    template <class U>
+    friend constexpr bool operator==(
+        const aligned_allocator&,
+        const aligned_allocator<U, Alignment, PadCapacity>&) noexcept {
+        return true;
+    }
+};
+
+}  // namespace my_vector
@@ -0,0 +1,264 @@
+/*
+ * concurrent_vector: сегментированный вектор, в который несколько потоков
+ * могут одновременно добавлять элементы без блокировок. Элементы никогда не
+ * перемещаются, поэтому чтение уже опубликованных элементов безопасно
+ * параллельно с добавлением новых.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_segmented_vector.h"
+
+namespace my_vector {
+
+/*
+ * push_back, emplace_back и grow_by захватывают индексы атомарным
+ * fetch_add и не ждут друг друга: единственная гонка — за выделение нового
+ * сегмента, которую проигравший поток разрешает одним compare_exchange.
+ *
+ * Элемент считается опубликованным, когда вернувший его индекс поток
+ * передал этот индекс другим потокам с синхронизацией (через atomic, мьютекс,
+ * join и т.п.); только такие элементы можно читать через operator[].
+ * size() учитывает и захваченные, но ещё конструируемые элементы.
+ *
+ * Если конструктор элемента бросает исключение, захваченная ячейка
+ * заполняется значением T(), а исключение передаётся дальше. Поэтому
+ * конструктор, который может бросить исключение, допускается, только если
+ * у T есть небросающий конструктор по умолчанию; иначе программа не
+ * компилируется. Нехватка памяти под сегмент для уже захваченного индекса
+ * приводит к std::terminate.
+ *
+ * Итераторы, clear и деструктор не синхронизированы с добавлением и
+ * предназначены для использования после того, как все производители
+ * завершились.
+ */
+template <class T, class Allocator = std::allocator<T>,
+          std::size_t FirstSegment = 64>
+class concurrent_vector {
+    using layout = detail::segment_layout<FirstSegment>;
+
+    static_assert(
+        std::is_pointer_v<typename std::allocator_traits<Allocator>::pointer>,
+        "concurrent_vector requires raw allocator pointers");
+
+   public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+    using iterator = detail::index_iterator<concurrent_vector>;
+    using const_iterator = detail::index_iterator<const concurrent_vector>;
+
+    concurrent_vector() = default;
+
+    explicit concurrent_vector(const Allocator& allocator)
+        : allocator_(allocator) {}
+
+    concurrent_vector(const concurrent_vector&) = delete;
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+    ~concurrent_vector() {
+        clear();
+        for (size_type segment = 0; segment < layout::max_segments;
+             ++segment) {
+            pointer block = segments_[segment].load(std::memory_order_relaxed);
+            if (block != nullptr) {
+                std::allocator_traits<allocator_type>::deallocate(
+                    allocator_, block, layout::segmentSize(segment));
+            }
+        }
+    }
+
+    constexpr Allocator get_allocator() const { return allocator_; }
+
+    // =============================
+    // Element access (cppreference)
+    // =============================
+    T& at(size_type position) {
+        if (position >= size()) {
+            throw std::out_of_range("Index is out of vector size");
+        }
+        return (*this)[position];
+    }
+
+    const T& at(size_type position) const {
+        if (position >= size()) {
+            throw std::out_of_range("Index is out of vector size");
+        }
+        return (*this)[position];
+    }
+
+    T& operator[](size_type position) {
+        size_type segment = layout::segmentOf(position);
+        pointer block = segments_[segment].load(std::memory_order_acquire);
+        return block[layout::offsetIn(position, segment)];
+    }
+
+    const T& operator[](size_type position) const {
+        return const_cast<concurrent_vector&>(*this)[position];
+    }
+
+    // ========================
+    // Iterators (cppreference)
+    // ========================
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(this, size()); }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, size());
+    }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    // =======================
+    // Capacity (cppreference)
+    // =======================
+
+    bool empty() const noexcept { return size() == 0; }
+
+    size_type size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    size_type max_size() const {
+        return std::allocator_traits<allocator_type>::max_size(allocator_);
+    }
+
+    // Заранее выделяет сегменты под new_capacity элементов; можно вызывать
+    // параллельно с добавлением
+    void reserve(size_type new_capacity) {
+        if (new_capacity > max_size()) {
+            throw std::length_error("");
+        }
+        if (new_capacity != 0) {
+            ensureSegments(0, new_capacity);
+        }
+    }
+
+    // ========================
+    // Modifiers (cppreference)
+    // ========================
+
+    // Возвращает индекс добавленного элемента
+    template <class... Args>
+    size_type emplace_back(Args&&... args) {
+        size_type index = size_.fetch_add(1, std::memory_order_relaxed);
+        size_type segment = layout::segmentOf(index);
+        constructAt(claimedSegment(segment) + layout::offsetIn(index, segment),
+                    std::forward<Args>(args)...);
+        return index;
+    }
+
+    size_type push_back(const T& value) { return emplace_back(value); }
+
+    size_type push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    // Захватывает count подряд идущих ячеек, заполняет их копиями value и
+    // возвращает индекс первой
+    size_type grow_by(size_type count, const T& value = T()) {
+        if (count == 0) {
+            return size();
+        }
+        size_type first = size_.fetch_add(count, std::memory_order_relaxed);
+        for (size_type segment = layout::segmentOf(first);
+             segment <= layout::segmentOf(first + count - 1); ++segment) {
+            claimedSegment(segment);
+        }
+        for (size_type i = first; i < first + count; ++i) {
+            constructAt(std::addressof((*this)[i]), value);
+        }
+        return first;
+    }
+
+    // Не синхронизирован с добавлением
+    void clear() noexcept {
+        size_type count = size_.load(std::memory_order_relaxed);
+        for (size_type i = count; i > 0; --i) {
+            std::allocator_traits<allocator_type>::destroy(
+                allocator_, std::addressof((*this)[i - 1]));
+        }
+        size_.store(0, std::memory_order_relaxed);
+    }
+
+   private:
+    // Таблица сегментов фиксированного размера: указатели публикуются
+    // compare_exchange и больше не меняются до деструктора
+    std::atomic<pointer> segments_[layout::max_segments]{};
+    std::atomic<size_type> size_{0};
+    [[no_unique_address]] allocator_type allocator_;
+
+    // Выделяет сегмент, если его ещё нет. Проигравший гонку поток
+    // освобождает свой блок и использует опубликованный
+    pointer allocateSegment(size_type segment) {
+        pointer block = std::allocator_traits<allocator_type>::allocate(
+            allocator_, layout::segmentSize(segment));
+        pointer expected = nullptr;
+        if (segments_[segment].compare_exchange_strong(
+                expected, block, std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            return block;
+        }
+        std::allocator_traits<allocator_type>::deallocate(
+            allocator_, block, layout::segmentSize(segment));
+        return expected;
+    }
+
+    // Сегмент для уже захваченных индексов: отказаться от них нельзя,
+    // поэтому исключение при выделении завершает программу
+    pointer claimedSegment(size_type segment) noexcept {
+        pointer block = segments_[segment].load(std::memory_order_acquire);
+        return block != nullptr ? block : allocateSegment(segment);
+    }
+
+    // Гарантирует наличие сегментов для индексов [first, last)
+    void ensureSegments(size_type first, size_type last) {
+        for (size_type segment = layout::segmentOf(first);
+             segment <= layout::segmentOf(last - 1); ++segment) {
+            if (segments_[segment].load(std::memory_order_acquire) ==
+                nullptr) {
+                allocateSegment(segment);
+            }
+        }
+    }
+
+    template <class... Args>
+    void constructAt(pointer slot, Args&&... args) {
+        static_assert(std::is_nothrow_constructible_v<T, Args&&...> or
+                          std::is_nothrow_default_constructible_v<T>,
+                      "a throwing element constructor requires a nothrow "
+                      "default constructor to fill the claimed slot");
+        try {
+            std::allocator_traits<allocator_type>::construct(
+                allocator_, slot, std::forward<Args>(args)...);
+        } catch (...) {
+            // ячейка уже захвачена и будет уничтожена в деструкторе
+            if constexpr (std::is_nothrow_default_constructible_v<T>) {
+                std::allocator_traits<allocator_type>::construct(allocator_,
+                                                                 slot);
+            }
+            throw;
+        }
+    }
+};
+
+}  // namespace my_vector
@@ -0,0 +1,508 @@
+/*
+ * inplace_vector (C++26): вектор с ёмкостью N, заданной при компиляции, и
+ * хранением элементов внутри объекта, без аллокатора. Для тривиальных T
+ * контейнер тривиально копируем и целиком пригоден для constexpr.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include "my_vector.h"
+
+namespace my_vector {
+
+// Тривиальные типы хранятся в обычном массиве: это сохраняет тривиальную
+// копируемость и позволяет использовать контейнер в constexpr. В
+// constexpr-вычислениях массив заполняется, так как результат константного
+// выражения не может содержать неинициализированных байтов
+template <class T, std::size_t N,
+          bool Trivial = std::is_trivially_default_constructible_v<T> and
+                         std::is_trivially_copyable_v<T>>
+struct inplace_storage {
+    constexpr inplace_storage() {
+        if (std::is_constant_evaluated()) {
+            std::fill_n(elements, N, T());
+        }
+    }
+
+    T elements[N];
+};
+
+// Остальные типы размещаются в объединении, элементы конструируются и
+// уничтожаются вручную
+template <class T, std::size_t N>
+    requires(N > 0)
+struct inplace_storage<T, N, false> {
+    constexpr inplace_storage() {}
+
+    constexpr inplace_storage(const inplace_storage&) = default;
+
+    constexpr inplace_storage& operator=(const inplace_storage&) = default;
+
+    constexpr ~inplace_storage()
+        requires std::is_trivially_destructible_v<T>
+    = default;
+
+    constexpr ~inplace_storage() {}
+
+    union {
+        T elements[N];
+    };
+};
+
+template <class T, bool Trivial>
+struct inplace_storage<T, 0, Trivial> {};
+
+template <class T, std::size_t N>
+class inplace_vector {
+    static constexpr bool trivially_copyable = std::is_trivially_copyable_v<T>;
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+    // Итератор тот же, что и у my_vector::vector
+    using iterator = typename vector<T>::iterator;
+    using const_iterator = typename vector<T>::const_iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    constexpr inplace_vector() noexcept = default;
+
+    constexpr explicit inplace_vector(size_type count) { resize(count); }
+
+    constexpr inplace_vector(size_type count, const T& value) {
+        resize(count, value);
+    }
+
+    template <std::input_iterator InputIt>
+    constexpr inplace_vector(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    template <container_compatible_range<T> Range>
+    constexpr inplace_vector(from_range_t, Range&& range) {
+        append_range(std::forward<Range>(range));
+    }
+
+    constexpr inplace_vector(std::initializer_list<T> init)
+        : inplace_vector(init.begin(), init.end()) {}
+
+    constexpr inplace_vector(const inplace_vector&)
+        requires trivially_copyable
+    = default;
+
+    constexpr inplace_vector(const inplace_vector& other) {
+        for (const T& element : other) {
+            unchecked_emplace_back(element);
+        }
+    }
+
+    constexpr inplace_vector(inplace_vector&&)
+        requires trivially_copyable
+    = default;
+
+    constexpr inplace_vector(inplace_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        for (T& element : other) {
+            unchecked_emplace_back(std::move(element));
+        }
+    }
+
+    constexpr ~inplace_vector()
+        requires trivially_copyable
+    = default;
+
+    constexpr ~inplace_vector() { clear(); }
+
+    constexpr inplace_vector& operator=(const inplace_vector&)
+        requires trivially_copyable
+    = default;
+
+    constexpr inplace_vector& operator=(const inplace_vector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    constexpr inplace_vector& operator=(inplace_vector&&)
+        requires trivially_copyable
+    = default;
+
+    constexpr inplace_vector& operator=(inplace_vector&& other) noexcept(
+        std::is_nothrow_move_assignable_v<T> and
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            assign(std::make_move_iterator(other.begin()),
+                   std::make_move_iterator(other.end()));
+        }
+        return *this;
+    }
+
+    constexpr inplace_vector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    constexpr void assign(size_type count, const T& value) {
+        if (count > N) {
+            throw std::bad_alloc();
+        }
+        size_type common = std::min(size_, count);
+        std::fill_n(data(), common, value);
+        if (count > size_) {
+            resize(count, value);
+        } else {
+            shrinkTo(count);
+        }
+    }
+
+    template <std::input_iterator InputIt>
+    constexpr void assign(InputIt first, InputIt last) {
+        size_type i = 0;
+        for (; i < size_ and first != last; ++i, ++first) {
+            data()[i] = *first;
+        }
+        shrinkTo(i);
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    constexpr void assign(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+    }
+
+    template <container_compatible_range<T> Range>
+    constexpr void assign_range(Range&& range) {
+        assign(std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    // =============================
+    // Element access (cppreference)
+    // =============================
+    constexpr T& at(size_type position) {
+        if (position >= size_) {
+            throw std::out_of_range("Index is out of vector size");
+        }
+        return data()[position];
+    }
+
+    constexpr const T& at(size_type position) const {
+        if (position >= size_) {
+            throw std::out_of_range("Index is out of vector size");
+        }
+        return data()[position];
+    }
+
+    constexpr T& operator[](size_type position) { return data()[position]; }
+
+    constexpr const T& operator[](size_type position) const {
+        return data()[position];
+    }
+
+    constexpr T& front() { return data()[0]; }
+
+    constexpr const T& front() const { return data()[0]; }
+
+    constexpr T& back() { return data()[size_ - 1]; }
+
+    constexpr const T& back() const { return data()[size_ - 1]; }
+
+    constexpr T* data() noexcept {
+        if constexpr (N == 0) {
+            return nullptr;
+        } else {
+            return storage_.elements;
+        }
+    }
+
+    constexpr const T* data() const noexcept {
+        return const_cast<inplace_vector*>(this)->data();
+    }
+
+    // ========================
+    // Iterators (cppreference)
+    // ========================
+
+    constexpr iterator begin() noexcept { return iterator(data()); }
+
+    constexpr const_iterator begin() const noexcept {
+        return const_iterator(const_cast<T*>(data()));
+    }
+
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+    constexpr iterator end() noexcept { return iterator(data() + size_); }
+
+    constexpr const_iterator end() const noexcept {
+        return const_iterator(const_cast<T*>(data()) + size_);
+    }
+
+    constexpr const_iterator cend() const noexcept { return end(); }
+
+    constexpr reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    constexpr const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    constexpr const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    constexpr reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    constexpr const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // =======================
+    // Capacity (cppreference)
+    // =======================
+
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr size_type size() const noexcept { return size_; }
+
+    static constexpr size_type max_size() noexcept { return N; }
+
+    static constexpr size_type capacity() noexcept { return N; }
+
+    static constexpr void reserve(size_type new_capacity) {
+        if (new_capacity > N) {
+            throw std::bad_alloc();
+        }
+    }
+
+    static constexpr void shrink_to_fit() noexcept {}
+
+    constexpr void resize(size_type count) {
+        if (count > N) {
+            throw std::bad_alloc();
+        }
+        while (size_ < count) {
+            unchecked_emplace_back();
+        }
+        shrinkTo(count);
+    }
+
+    constexpr void resize(size_type count, const T& value) {
+        if (count > N) {
+            throw std::bad_alloc();
+        }
+        while (size_ < count) {
+            unchecked_emplace_back(value);
+        }
+        shrinkTo(count);
+    }
+
+    // ========================
+    // Modifiers (cppreference)
+    // ========================
+
+    template <class... Args>
+    constexpr reference emplace_back(Args&&... args) {
+        if (size_ == N) {
+            throw std::bad_alloc();
+        }
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+
+    constexpr reference push_back(const T& value) {
+        return emplace_back(value);
+    }
+
+    constexpr reference push_back(T&& value) {
+        return emplace_back(std::move(value));
+    }
+
+    // Возвращают указатель на добавленный элемент или nullptr, если
+    // контейнер заполнен
+    template <class... Args>
+    constexpr pointer try_emplace_back(Args&&... args) {
+        if (size_ == N) {
+            return nullptr;
+        }
+        return std::addressof(
+            unchecked_emplace_back(std::forward<Args>(args)...));
+    }
+
+    constexpr pointer try_push_back(const T& value) {
+        return try_emplace_back(value);
+    }
+
+    constexpr pointer try_push_back(T&& value) {
+        return try_emplace_back(std::move(value));
+    }
+
+    // Вызывающий гарантирует, что size() < capacity()
+    template <class... Args>
+    constexpr reference unchecked_emplace_back(Args&&... args) {
+        T* element = std::construct_at(data() + size_,
+                                       std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    constexpr reference unchecked_push_back(const T& value) {
+        return unchecked_emplace_back(value);
+    }
+
+    constexpr reference unchecked_push_back(T&& value) {
+        return unchecked_emplace_back(std::move(value));
+    }
+
+    template <container_compatible_range<T> Range>
+    constexpr void append_range(Range&& range) {
+        if constexpr (std::ranges::sized_range<Range>) {
+            if (size_ + std::ranges::size(range) > N) {
+                throw std::bad_alloc();
+            }
+        }
+        for (auto&& element : range) {
+            emplace_back(std::forward<decltype(element)>(element));
+        }
+    }
+
+    // Добавляет элементы, пока есть место, и возвращает итератор на первый
+    // не поместившийся элемент диапазона
+    template <container_compatible_range<T> Range>
+    constexpr std::ranges::borrowed_iterator_t<Range> try_append_range(
+        Range&& range) {
+        auto it = std::ranges::begin(range);
+        auto last = std::ranges::end(range);
+        for (; size_ < N and it != last; ++it) {
+            unchecked_emplace_back(*it);
+        }
+        return it;
+    }
+
+    constexpr void pop_back() {
+        --size_;
+        std::destroy_at(data() + size_);
+    }
+
+    constexpr void clear() noexcept { shrinkTo(0); }
+
+    template <class... Args>
+    constexpr iterator emplace(const_iterator position, Args&&... args) {
+        size_type index = position.base() - data();
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    constexpr iterator insert(const_iterator position, const T& value) {
+        return emplace(position, value);
+    }
+
+    constexpr iterator insert(const_iterator position, T&& value) {
+        return emplace(position, std::move(value));
+    }
+
+    constexpr iterator insert(const_iterator position, size_type count,
+                              const T& value) {
+        size_type index = position.base() - data();
+        if (size_ + count > N) {
+            throw std::bad_alloc();
+        }
+        size_type old_size = size_;
+        resize(size_ + count, value);
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+    }
+
+    template <std::input_iterator InputIt>
+    constexpr iterator insert(const_iterator position, InputIt first,
+                              InputIt last) {
+        return insert_range(position, std::ranges::subrange(first, last));
+    }
+
+    constexpr iterator insert(const_iterator position,
+                              std::initializer_list<T> init) {
+        return insert_range(position, init);
+    }
+
+    template <container_compatible_range<T> Range>
+    constexpr iterator insert_range(const_iterator position, Range&& range) {
+        size_type index = position.base() - data();
+        size_type old_size = size_;
+        append_range(std::forward<Range>(range));
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+    }
+
+    constexpr iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+
+    constexpr iterator erase(const_iterator first, const_iterator last) {
+        size_type index = first.base() - data();
+        iterator new_end = std::move(iterator(last.base()), end(),
+                                     iterator(first.base()));
+        shrinkTo(new_end - begin());
+        return begin() + index;
+    }
+
+    constexpr void swap(inplace_vector& other) noexcept(
+        std::is_nothrow_swappable_v<T> and
+        std::is_nothrow_move_constructible_v<T>) {
+        inplace_vector& shorter = size_ < other.size_ ? *this : other;
+        inplace_vector& longer = size_ < other.size_ ? other : *this;
+        size_type common = shorter.size_;
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        for (size_type i = common; i < longer.size_; ++i) {
+            shorter.unchecked_emplace_back(std::move(longer[i]));
+        }
+        longer.shrinkTo(common);
+    }
+
+    friend constexpr bool operator==(const inplace_vector& lhs,
+                                     const inplace_vector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend constexpr auto operator<=>(const inplace_vector& lhs,
+                                      const inplace_vector& rhs) {
+        return std::lexicographical_compare_three_way(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+   private:
+    size_type size_{0};
+    [[no_unique_address]] inplace_storage<T, N> storage_;
+
+    // Уничтожает элементы [new_size, size_)
+    constexpr void shrinkTo(size_type new_size) noexcept {
+        if (new_size < size_) {
+            std::destroy(data() + new_size, data() + size_);
+            size_ = new_size;
+        }
+    }
+};
+
+}  // namespace my_vector
@@ -0,0 +1,485 @@
+/*
+ * segmented_vector: последовательность, которая при росте не перемещает
+ * элементы. Память выделяется сегментами, каждый следующий вдвое больше
+ * предыдущего, поэтому указатели и ссылки на элементы остаются
+ * действительными до их удаления, а номер сегмента вычисляется по индексу
+ * за O(1).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_vector.h"
+
+namespace my_vector {
+
+namespace detail {
+
+/*
+ * Сегмент k содержит FirstSegment * 2^k элементов и начинается с индекса
+ * FirstSegment * (2^k - 1). Для индекса i число i + FirstSegment лежит в
+ * [FirstSegment * 2^k, FirstSegment * 2^(k + 1)), так что k определяется
+ * старшим битом, а смещение внутри сегмента — остальными битами.
+ */
+template <std::size_t FirstSegment>
+struct segment_layout {
+    static_assert(std::has_single_bit(FirstSegment),
+                  "FirstSegment must be a power of two");
+
+    static constexpr std::size_t first_segment_bits =
+        std::countr_zero(FirstSegment);
+
+    // Число сегментов, которыми покрывается весь диапазон size_t
+    static constexpr std::size_t max_segments =
+        std::numeric_limits<std::size_t>::digits - first_segment_bits;
+
+    // "| FirstSegment" не меняет результат для допустимых индексов, но
+    // исключает для компилятора переполнение при index + FirstSegment == 0
+    static constexpr std::size_t segmentOf(std::size_t index) {
+        return std::bit_width((index + FirstSegment) | FirstSegment) - 1 -
+               first_segment_bits;
+    }
+
+    static constexpr std::size_t offsetIn(std::size_t index,
+                                          std::size_t segment) {
+        return index + FirstSegment - (FirstSegment << segment);
+    }
+
+    static constexpr std::size_t segmentSize(std::size_t segment) {
+        return FirstSegment << segment;
+    }
+
+    // Индекс первого элемента сегмента, он же суммарная ёмкость
+    // предыдущих сегментов
+    static constexpr std::size_t segmentStart(std::size_t segment) {
+        return (FirstSegment << segment) - FirstSegment;
+    }
+};
+
+// Итератор произвольного доступа по индексу для контейнеров, элементы
+// которых не лежат в памяти подряд. Container может быть const
+template <class Container>
+class index_iterator {
+    using element_type =
+        std::conditional_t<std::is_const_v<Container>,
+                           const typename Container::value_type,
+                           typename Container::value_type>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename Container::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = element_type*;
+    using reference = element_type&;
+
+    index_iterator() = default;
+    index_iterator(Container* owner, std::size_t index)
+        : owner_(owner), index_(index) {}
+
+    // iterator неявно преобразуется в const_iterator
+    template <class Other>
+        requires(std::is_const_v<Container> and
+                 std::same_as<const Other, Container>)
+    index_iterator(const index_iterator<Other>& other)
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    pointer operator->() const { return std::addressof(**this); }
+
+    reference operator[](difference_type n) const {
+        return (*owner_)[index_ + n];
+    }
+
+    index_iterator& operator++() {
+        ++index_;
+        return *this;
+    }
+
+    index_iterator operator++(int) {
+        index_iterator old(*this);
+        ++index_;
+        return old;
+    }
+
+    index_iterator& operator--() {
+        --index_;
+        return *this;
+    }
+
+    index_iterator operator--(int) {
+        index_iterator old(*this);
+        --index_;
+        return old;
+    }
+
+    index_iterator& operator+=(difference_type n) {
+        index_ += n;
+        return *this;
+    }
+
+    index_iterator& operator-=(difference_type n) {
+        index_ -= n;
+        return *this;
+    }
+
+    index_iterator operator+(difference_type n) const {
+        return index_iterator(owner_, index_ + n);
+    }
+
+    index_iterator operator-(difference_type n) const {
+        return index_iterator(owner_, index_ - n);
+    }
+
+    friend index_iterator operator+(difference_type n,
+                                    const index_iterator& it) {
+        return it + n;
+    }
+
+    difference_type operator-(const index_iterator& other) const {
+        return static_cast<difference_type>(index_) -
+               static_cast<difference_type>(other.index_);
+    }
+
+    bool operator==(const index_iterator& other) const {
+        return index_ == other.index_;
+    }
+
+    auto operator<=>(const index_iterator& other) const {
+        return index_ <=> other.index_;
+    }
+
+   private:
+    template <class>
+    friend class index_iterator;
+
+    Container* owner_{nullptr};
+    std::size_t index_{0};
+};
+
+}  // namespace detail
+
+template <class T, class Allocator = std::allocator<T>,
+          std::size_t FirstSegment = 16>
+class segmented_vector {
+    using layout = detail::segment_layout<FirstSegment>;
+
+   public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = std::allocator_traits<Allocator>::pointer;
+    using const_pointer = std::allocator_traits<Allocator>::const_pointer;
+
+    using iterator = detail::index_iterator<segmented_vector>;
+    using const_iterator = detail::index_iterator<const segmented_vector>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    segmented_vector() = default;
+
+    explicit segmented_vector(const Allocator& allocator)
+        : segments_(segment_allocator(allocator)), allocator_(allocator) {}
+
+    segmented_vector(std::initializer_list<T> init,
+                     const Allocator& allocator = Allocator())
+        : segmented_vector(allocator) {
+        try {
+            for (const T& value : init) {
+                push_back(value);
+            }
+        } catch (...) {
+            deepClear();
+            throw;
+        }
+    }
+
+    segmented_vector(const segmented_vector& other)
+        : segmented_vector(std::allocator_traits<Allocator>::
+                               select_on_container_copy_construction(
+                                   other.allocator_)) {
+        try {
+            reserve(other.size_);
+            for (const T& value : other) {
+                push_back(value);
+            }
+        } catch (...) {
+            deepClear();
+            throw;
+        }
+    }
+
+    segmented_vector(segmented_vector&& other) noexcept
+        : segments_(std::move(other.segments_)),
+          size_(std::exchange(other.size_, 0)),
+          allocator_(std::move(other.allocator_)) {}
+
+    ~segmented_vector() { deepClear(); }
+
+    segmented_vector& operator=(const segmented_vector& other) {
+        if (this != &other) {
+            segmented_vector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    segmented_vector& operator=(segmented_vector&& other) noexcept(
+        std::allocator_traits<
+            Allocator>::propagate_on_container_move_assignment::value or
+        std::allocator_traits<Allocator>::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+        if constexpr (not std::allocator_traits<allocator_type>::
+                          propagate_on_container_move_assignment::value) {
+            if (allocator_ != other.allocator_) {
+                // сегменты other нельзя освободить нашим аллокатором
+                clear();
+                reserve(other.size_);
+                for (T& value : other) {
+                    push_back(std::move(value));
+                }
+                other.deepClear();
+                return *this;
+            }
+        }
+        deepClear();
+        segments_ = std::move(other.segments_);
+        size_ = std::exchange(other.size_, 0);
+        if constexpr (std::allocator_traits<allocator_type>::
+                          propagate_on_container_move_assignment::value) {
+            allocator_ = std::move(other.allocator_);
+        }
+        return *this;
+    }
+
+    constexpr Allocator get_allocator() const { return allocator_; }
+
+    // =============================
+    // Element access (cppreference)
+    // =============================
+    T& at(size_type position) {
+        if (position >= size_) {
+            throw std::out_of_range("Index is out of vector size");
+        }
+        return (*this)[position];
+    }
+
+    const T& at(size_type position) const {
+        if (position >= size_) {
+            throw std::out_of_range("Index is out of vector size");
+        }
+        return (*this)[position];
+    }
+
+    T& operator[](size_type position) {
+        size_type segment = layout::segmentOf(position);
+        return segments_[segment][layout::offsetIn(position, segment)];
+    }
+
+    const T& operator[](size_type position) const {
+        return const_cast<segmented_vector&>(*this)[position];
+    }
+
+    T& front() { return (*this)[0]; }
+
+    const T& front() const { return (*this)[0]; }
+
+    T& back() { return (*this)[size_ - 1]; }
+
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    // ========================
+    // Iterators (cppreference)
+    // ========================
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(this, size_); }
+
+    const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // =======================
+    // Capacity (cppreference)
+    // =======================
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    size_type size() const noexcept { return size_; }
+
+    size_type max_size() const {
+        return std::allocator_traits<allocator_type>::max_size(allocator_);
+    }
+
+    size_type capacity() const noexcept {
+        return layout::segmentStart(segments_.size());
+    }
+
+    // Выделяет недостающие сегменты; элементы не перемещаются
+    void reserve(size_type new_capacity) {
+        if (new_capacity > max_size()) {
+            throw std::length_error("");
+        }
+        while (capacity() < new_capacity) {
+            addSegment();
+        }
+    }
+
+    // Освобождает сегменты, в которых не осталось элементов
+    void shrink_to_fit() {
+        while (not segments_.empty() and
+               layout::segmentStart(segments_.size() - 1) >= size_) {
+            size_type segment = segments_.size() - 1;
+            std::allocator_traits<allocator_type>::deallocate(
+                allocator_, segments_[segment], layout::segmentSize(segment));
+            segments_.pop_back();
+        }
+    }
+
+    // ========================
+    // Modifiers (cppreference)
+    // ========================
+
+    void clear() noexcept { destroyTail(0); }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity()) {
+            addSegment();
+        }
+        T* element = std::addressof((*this)[size_]);
+        std::allocator_traits<allocator_type>::construct(
+            allocator_, element, std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() { destroyTail(size_ - 1); }
+
+    void resize(size_type count) {
+        reserve(count);
+        while (size_ < count) {
+            emplace_back();
+        }
+        destroyTail(count);
+    }
+
+    void resize(size_type count, const T& value) {
+        reserve(count);
+        while (size_ < count) {
+            emplace_back(value);
+        }
+        destroyTail(count);
+    }
+
+    void swap(segmented_vector& other) noexcept {
+        segments_.swap(other.segments_);
+        std::swap(size_, other.size_);
+        if constexpr (std::allocator_traits<
+                          allocator_type>::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(allocator_, other.allocator_);
+        }
+    }
+
+    friend bool operator==(const segmented_vector& lhs,
+                           const segmented_vector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend auto operator<=>(const segmented_vector& lhs,
+                            const segmented_vector& rhs) {
+        return std::lexicographical_compare_three_way(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+   private:
+    using segment_allocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<pointer>;
+
+    // Таблица сегментов сама растёт как обычный вектор, но хранит только
+    // указатели, поэтому элементы при этом не перемещаются
+    vector<pointer, segment_allocator> segments_;
+    size_type size_{0};
+    [[no_unique_address]] allocator_type allocator_;
+
+    void addSegment() {
+        size_type segment = segments_.size();
+        if (layout::segmentSize(segment) > max_size() - capacity()) {
+            throw std::length_error("");
+        }
+        pointer block = std::allocator_traits<allocator_type>::allocate(
+            allocator_, layout::segmentSize(segment));
+        try {
+            segments_.push_back(block);
+        } catch (...) {
+            std::allocator_traits<allocator_type>::deallocate(
+                allocator_, block, layout::segmentSize(segment));
+            throw;
+        }
+    }
+
+    // Уничтожает элементы [new_size, size_) с конца
+    void destroyTail(size_type new_size) noexcept {
+        for (; size_ > new_size; --size_) {
+            std::allocator_traits<allocator_type>::destroy(
+                allocator_, std::addressof((*this)[size_ - 1]));
+        }
+    }
+
+    void deepClear() noexcept {
+        clear();
+        shrink_to_fit();
+    }
+};
+
+}  // namespace my_vector
+
+namespace std {
+template <class T, class Allocator, std::size_t FirstSegment>
+void swap(
+    my_vector::segmented_vector<T, Allocator, FirstSegment>& lhs,
+    my_vector::segmented_vector<T, Allocator, FirstSegment>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+}  // namespace std
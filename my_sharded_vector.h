@@ -0,0 +1,191 @@
+/*
+ * sharded_vector: набор независимых векторов-шардов, по одному на поток.
+ * Потоки добавляют элементы каждый в свой шард без синхронизации, после чего
+ * merge/flatten параллельно собирают все шарды в один my_vector::vector.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "my_vector.h"
+
+namespace my_vector {
+
+// Размер строки кэша, по которому выравниваются шарды, чтобы соседние
+// потоки не делили одну строку
+inline constexpr std::size_t cache_line_size = 64;
+
+template <class T, class Allocator = std::allocator<T>>
+class sharded_vector {
+   public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using shard_type = vector<T, Allocator>;
+
+    explicit sharded_vector(
+        size_type shard_count = std::max(1u,
+                                         std::thread::hardware_concurrency()),
+        const Allocator& allocator = Allocator())
+        : shards_(shard_allocator(allocator)), allocator_(allocator) {
+        shards_.reserve(shard_count);
+        for (size_type i = 0; i < shard_count; ++i) {
+            shards_.emplace_back(allocator);
+        }
+    }
+
+    constexpr Allocator get_allocator() const { return allocator_; }
+
+    size_type shard_count() const noexcept { return shards_.size(); }
+
+    // Шард с номером index; каждый поток должен работать только со своим
+    shard_type& shard(size_type index) { return shards_[index].elements; }
+
+    const shard_type& shard(size_type index) const {
+        return shards_[index].elements;
+    }
+
+    // Суммарный размер; не синхронизирован с добавлением в шарды
+    size_type size() const noexcept {
+        size_type total = 0;
+        for (const Shard& shard : shards_) {
+            total += shard.elements.size();
+        }
+        return total;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    void clear() {
+        for (Shard& shard : shards_) {
+            shard.elements.clear();
+        }
+    }
+
+    /*
+     * Переносит элементы всех шардов в конец destination в порядке номеров
+     * шардов. Смещения шардов вычисляются префиксными суммами, память
+     * выделяется один раз, а крупные шарды конструируются в
+     * неинициализированной памяти destination параллельно, каждый в своём
+     * потоке. Шарды остаются пустыми, но сохраняют ёмкость.
+     *
+     * Если перемещение T может бросить исключение, элементы копируются, и
+     * при исключении destination (кроме ёмкости) и шарды не меняются.
+     */
+    void merge(vector<T, Allocator>& destination) {
+        vector<size_type> offsets(shards_.size() + 1);
+        for (size_type i = 0; i < shards_.size(); ++i) {
+            offsets[i + 1] = offsets[i] + shards_[i].elements.size();
+        }
+        size_type total = offsets[shards_.size()];
+        if (total == 0) {
+            return;
+        }
+        using traits = std::allocator_traits<Allocator>;
+        const Allocator allocator = destination.get_allocator();
+        destination.append_uninitialized(total, [&](T* data, size_type) {
+            vector<char> constructed(shards_.size());
+            std::exception_ptr error = forEachShard([&](size_type i) {
+                Allocator local = allocator;
+                auto& elements = shards_[i].elements;
+                T* target = data + offsets[i];
+                size_type j = 0;
+                try {
+                    for (; j < elements.size(); ++j) {
+                        traits::construct(local, target + j,
+                                          std::move_if_noexcept(elements[j]));
+                    }
+                } catch (...) {
+                    destroyRange(local, target, j);
+                    throw;
+                }
+                constructed[i] = true;
+            });
+            if (error) {
+                Allocator local = allocator;
+                for (size_type i = 0; i < shards_.size(); ++i) {
+                    if (constructed[i]) {
+                        destroyRange(local, data + offsets[i],
+                                     offsets[i + 1] - offsets[i]);
+                    }
+                }
+                std::rethrow_exception(error);
+            }
+        });
+        clear();
+    }
+
+    vector<T, Allocator> flatten() {
+        vector<T, Allocator> result(allocator_);
+        merge(result);
+        return result;
+    }
+
+   private:
+    struct alignas(cache_line_size) Shard {
+        explicit Shard(const Allocator& allocator) : elements(allocator) {}
+
+        shard_type elements;
+    };
+
+    using shard_allocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Shard>;
+
+    // Шардов с меньшим числом элементов не хватает, чтобы окупить запуск
+    // потока, они переносятся в вызывающем
+    static constexpr size_type parallel_threshold = 16 * 1024;
+
+    vector<Shard, shard_allocator> shards_;
+    [[no_unique_address]] allocator_type allocator_;
+
+    static void destroyRange(Allocator& allocator, T* first, size_type count) {
+        for (size_type i = 0; i < count; ++i) {
+            std::allocator_traits<Allocator>::destroy(allocator, first + i);
+        }
+    }
+
+    // Выполняет function(i) для всех шардов: крупные в отдельных потоках,
+    // остальные в вызывающем. Возвращает первое перехваченное исключение
+    template <class Function>
+    std::exception_ptr forEachShard(Function function) {
+        vector<std::exception_ptr> errors(shards_.size());
+        auto run = [&function, &errors](size_type i) {
+            try {
+                function(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        vector<std::thread> workers;
+        for (size_type i = 0; i < shards_.size(); ++i) {
+            if (shards_[i].elements.size() >= parallel_threshold) {
+                try {
+                    workers.emplace_back(run, i);
+                    continue;
+                } catch (...) {
+                    // поток не создан, шард переносится здесь
+                }
+            }
+            run(i);
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        for (std::exception_ptr& error : errors) {
+            if (error) {
+                return error;
+            }
+        }
+        return nullptr;
+    }
+};
+
+}  // namespace my_vector
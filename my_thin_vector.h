@@ -0,0 +1,576 @@
+/*
+ * thin_vector: вектор, объект которого состоит из одного указателя на
+ * элементы. Размер и ёмкость хранятся в заголовке перед элементами в том же
+ * блоке памяти, пустой вектор не выделяет памяти и хранит nullptr.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_vector.h"
+
+namespace my_vector {
+
+template <class T, class Allocator = std::allocator<T>,
+          class GrowthPolicy = doubling_growth>
+class thin_vector {
+    static_assert(
+        std::is_pointer_v<typename std::allocator_traits<Allocator>::pointer>,
+        "thin_vector requires raw allocator pointers");
+
+   public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+    // Итератор тот же, что и у my_vector::vector
+    using iterator = typename vector<T>::iterator;
+    using const_iterator = typename vector<T>::const_iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    constexpr thin_vector() noexcept(noexcept(Allocator())) = default;
+
+    constexpr explicit thin_vector(const Allocator& allocator) noexcept
+        : allocator_(allocator) {}
+
+    thin_vector(size_type count, const T& value,
+                const Allocator& allocator = Allocator())
+        : allocator_(allocator) {
+        try {
+            resize(count, value);
+        } catch (...) {
+            deepClear();
+            throw;
+        }
+    }
+
+    explicit thin_vector(size_type count,
+                         const Allocator& allocator = Allocator())
+        : allocator_(allocator) {
+        try {
+            resize(count);
+        } catch (...) {
+            deepClear();
+            throw;
+        }
+    }
+
+    template <std::input_iterator InputIt>
+    thin_vector(InputIt first, InputIt last,
+                const Allocator& allocator = Allocator())
+        : allocator_(allocator) {
+        try {
+            assign(first, last);
+        } catch (...) {
+            deepClear();
+            throw;
+        }
+    }
+
+    thin_vector(std::initializer_list<T> init,
+                const Allocator& allocator = Allocator())
+        : thin_vector(init.begin(), init.end(), allocator) {}
+
+    thin_vector(const thin_vector& other)
+        : allocator_(std::allocator_traits<Allocator>::
+                         select_on_container_copy_construction(
+                             other.allocator_)),
+          growth_policy_(other.growth_policy_) {
+        try {
+            assign(other.begin(), other.end());
+        } catch (...) {
+            deepClear();
+            throw;
+        }
+    }
+
+    constexpr thin_vector(thin_vector&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          allocator_(std::move(other.allocator_)),
+          growth_policy_(std::move(other.growth_policy_)) {}
+
+    ~thin_vector() { deepClear(); }
+
+    thin_vector& operator=(const thin_vector& other) {
+        if (this == &other) {
+            return *this;
+        }
+        if constexpr (std::allocator_traits<allocator_type>::
+                          propagate_on_container_copy_assignment::value) {
+            if (allocator_ != other.allocator_) {
+                deepClear();
+            }
+            allocator_ = other.allocator_;
+        }
+        growth_policy_ = other.growth_policy_;
+        assign(other.begin(), other.end());
+        return *this;
+    }
+
+    thin_vector& operator=(thin_vector&& other) noexcept(
+        std::allocator_traits<
+            Allocator>::propagate_on_container_move_assignment::value or
+        std::allocator_traits<Allocator>::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+        growth_policy_ = other.growth_policy_;
+        if constexpr (std::allocator_traits<allocator_type>::
+                          propagate_on_container_move_assignment::value) {
+            deepClear();
+            allocator_ = std::move(other.allocator_);
+        } else if (allocator_ != other.allocator_) {
+            assign(std::make_move_iterator(other.begin()),
+                   std::make_move_iterator(other.end()));
+            other.deepClear();
+            return *this;
+        } else {
+            deepClear();
+        }
+        data_ = std::exchange(other.data_, nullptr);
+        return *this;
+    }
+
+    thin_vector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    void assign(size_type count, const T& value) {
+        if (count > capacity()) {
+            thin_vector(count, value, allocator_).swap(*this);
+            return;
+        }
+        std::fill_n(data_, std::min(size(), count), value);
+        resize(count, value);
+    }
+
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last) {
+        if constexpr (std::forward_iterator<InputIt>) {
+            size_type count = std::distance(first, last);
+            if (count > capacity()) {
+                // старые элементы не нужны: выделяем новый блок сразу
+                pointer new_data = allocateBlock(nextCapacity(count, true));
+                try {
+                    auto next = [&first]() -> decltype(auto) {
+                        return *first++;
+                    };
+                    detail::construct_from(allocator_, new_data, count, next);
+                } catch (...) {
+                    deallocateBlock(new_data);
+                    throw;
+                }
+                deepClear();
+                data_ = new_data;
+                header(data_)->size = count;
+                return;
+            }
+        }
+        size_type i = 0;
+        for (; i < size() and first != last; ++i, ++first) {
+            data_[i] = *first;
+        }
+        destroyTail(i);
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void assign(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+    }
+
+    constexpr Allocator get_allocator() const { return allocator_; }
+
+    constexpr GrowthPolicy get_growth_policy() const {
+        return growth_policy_;
+    }
+
+    // =============================
+    // Element access (cppreference)
+    // =============================
+    T& at(size_type position) {
+        if (position >= size()) {
+            throw std::out_of_range("Index is out of vector size");
+        }
+        return data_[position];
+    }
+
+    const T& at(size_type position) const {
+        if (position >= size()) {
+            throw std::out_of_range("Index is out of vector size");
+        }
+        return data_[position];
+    }
+
+    T& operator[](size_type position) { return data_[position]; }
+
+    const T& operator[](size_type position) const { return data_[position]; }
+
+    T& front() { return data_[0]; }
+
+    const T& front() const { return data_[0]; }
+
+    T& back() { return data_[size() - 1]; }
+
+    const T& back() const { return data_[size() - 1]; }
+
+    T* data() noexcept { return data_; }
+
+    const T* data() const noexcept { return data_; }
+
+    // ========================
+    // Iterators (cppreference)
+    // ========================
+
+    iterator begin() noexcept { return iterator(data_); }
+
+    const_iterator begin() const noexcept { return const_iterator(data_); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(data_ + size()); }
+
+    const_iterator end() const noexcept {
+        return const_iterator(data_ + size());
+    }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // =======================
+    // Capacity (cppreference)
+    // =======================
+
+    constexpr bool empty() const noexcept { return size() == 0; }
+
+    constexpr size_type size() const noexcept {
+        return data_ == nullptr ? 0 : header(data_)->size;
+    }
+
+    constexpr size_type capacity() const noexcept {
+        return data_ == nullptr ? 0 : header(data_)->capacity;
+    }
+
+    size_type max_size() const {
+        std::size_t block_max =
+            (std::numeric_limits<std::size_t>::max() - header_bytes) /
+            sizeof(T);
+        return std::min<std::size_t>(
+            block_max, std::allocator_traits<Allocator>::max_size(allocator_));
+    }
+
+    void reserve(size_type new_capacity) {
+        if (new_capacity > max_size()) {
+            throw std::length_error("");
+        }
+        if (new_capacity > capacity()) {
+            reallocate(new_capacity);
+        }
+    }
+
+    // Пустой вектор освобождает блок целиком
+    void shrink_to_fit() {
+        if (empty()) {
+            deepClear();
+        } else if (capacity() > size()) {
+            reallocate(size());
+        }
+    }
+
+    // ========================
+    // Modifiers (cppreference)
+    // ========================
+
+    void clear() noexcept { destroyTail(0); }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args) {
+        size_type old_size = size();
+        if (old_size == capacity()) {
+            growAndEmplaceBack(std::forward<Args>(args)...);
+        } else {
+            std::allocator_traits<allocator_type>::construct(
+                allocator_, data_ + old_size, std::forward<Args>(args)...);
+            header(data_)->size = old_size + 1;
+        }
+        return data_[old_size];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() { destroyTail(size() - 1); }
+
+    // Новый элемент добавляется в конец и поворотом переносится на место
+    template <class... Args>
+    iterator emplace(const_iterator position, Args&&... args) {
+        size_type index = position.base() - data_;
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator position, const T& value) {
+        return emplace(position, value);
+    }
+
+    iterator insert(const_iterator position, T&& value) {
+        return emplace(position, std::move(value));
+    }
+
+    template <std::input_iterator InputIt>
+    iterator insert(const_iterator position, InputIt first, InputIt last) {
+        size_type index = position.base() - data_;
+        size_type old_size = size();
+        if constexpr (std::forward_iterator<InputIt>) {
+            reserve(old_size + std::distance(first, last));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator position, std::initializer_list<T> init) {
+        return insert(position, init.begin(), init.end());
+    }
+
+    iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        size_type index = first.base() - data_;
+        iterator new_end =
+            std::move(iterator(last.base()), end(), iterator(first.base()));
+        destroyTail(new_end - begin());
+        return begin() + index;
+    }
+
+    void resize(size_type count) {
+        if (count > capacity()) {
+            reallocate(nextCapacity(count));
+        }
+        while (size() < count) {
+            emplace_back();
+        }
+        destroyTail(count);
+    }
+
+    void resize(size_type count, const T& value) {
+        if (count <= size()) {
+            destroyTail(count);
+            return;
+        }
+        if (count > capacity()) {
+            // value может оказаться элементом вектора
+            T copy(value);
+            reallocate(nextCapacity(count));
+            while (size() < count) {
+                emplace_back(copy);
+            }
+            return;
+        }
+        while (size() < count) {
+            emplace_back(value);
+        }
+    }
+
+    void swap(thin_vector& other) noexcept {
+        std::swap(data_, other.data_);
+        if constexpr (std::allocator_traits<
+                          allocator_type>::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(allocator_, other.allocator_);
+        }
+        std::swap(growth_policy_, other.growth_policy_);
+    }
+
+    friend bool operator==(const thin_vector& lhs, const thin_vector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend auto operator<=>(const thin_vector& lhs, const thin_vector& rhs) {
+        return std::lexicographical_compare_three_way(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+   private:
+    struct Header {
+        size_type size;
+        size_type capacity;
+    };
+
+    // Блок выделяется единицами Unit, выровненными и под заголовок, и под T;
+    // элементы начинаются сразу после заголовка
+    static constexpr std::size_t alignment =
+        std::max(alignof(Header), alignof(T));
+    static constexpr std::size_t header_bytes =
+        (sizeof(Header) + alignment - 1) / alignment * alignment;
+
+    struct alignas(alignment) Unit {
+        std::byte bytes[alignment];
+    };
+
+    using unit_allocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Unit>;
+
+    pointer data_{nullptr};
+    [[no_unique_address]] allocator_type allocator_;
+    [[no_unique_address]] growth_policy growth_policy_;
+
+    static Header* header(pointer ptr) {
+        return reinterpret_cast<Header*>(reinterpret_cast<std::byte*>(ptr) -
+                                         header_bytes);
+    }
+
+    static constexpr std::size_t unitsFor(size_type capacity) {
+        return (header_bytes + capacity * sizeof(T) + alignment - 1) /
+               alignment;
+    }
+
+    // Ёмкость, которую следует выделить, чтобы вместить required элементов.
+    // exact отключает стратегию роста
+    size_type nextCapacity(size_type required, bool exact = false) const {
+        if (required > max_size()) {
+            throw std::length_error("");
+        }
+        if (exact) {
+            return required;
+        }
+        size_type new_capacity =
+            growth_policy_.next_capacity(capacity(), required, sizeof(T));
+        return std::clamp(new_capacity, required, max_size());
+    }
+
+    // Выделяет блок с заголовком не менее чем на count элементов; запас,
+    // выделенный аллокатором сверх запроса, идёт в ёмкость
+    pointer allocateBlock(size_type count) {
+        unit_allocator units(allocator_);
+        auto [block, allocated] =
+            my_vector::allocate_at_least(units, unitsFor(count));
+        size_type capacity = std::min<std::size_t>(
+            (allocated * alignment - header_bytes) / sizeof(T), max_size());
+        std::byte* bytes = reinterpret_cast<std::byte*>(std::to_address(block));
+        ::new (static_cast<void*>(bytes)) Header{0, capacity};
+        return reinterpret_cast<pointer>(bytes + header_bytes);
+    }
+
+    void deallocateBlock(pointer ptr) {
+        unit_allocator units(allocator_);
+        Header* block = header(ptr);
+        std::size_t count = unitsFor(block->capacity);
+        std::allocator_traits<unit_allocator>::deallocate(
+            units, reinterpret_cast<Unit*>(block), count);
+    }
+
+    // Уничтожает элементы [new_size, size())
+    void destroyTail(size_type new_size) noexcept {
+        size_type old_size = size();
+        if (new_size < old_size) {
+            detail::destroy_elements(allocator_, data_ + new_size,
+                                     old_size - new_size);
+            header(data_)->size = new_size;
+        }
+    }
+
+    // Переносит элементы в новый блок на new_capacity элементов тем же
+    // способом, что и vector::reallocate
+    void reallocate(size_type new_capacity) {
+        size_type old_size = size();
+        pointer new_data = allocateBlock(new_capacity);
+        if (data_ != nullptr) {
+            try {
+                detail::relocate(allocator_, data_, old_size, new_data);
+            } catch (...) {
+                deallocateBlock(new_data);
+                throw;
+            }
+            deallocateBlock(data_);
+        }
+        data_ = new_data;
+        header(data_)->size = old_size;
+    }
+
+    // Добавление в заполненный вектор. args могут ссылаться на его
+    // элементы, поэтому новый элемент создаётся в новом блоке раньше, чем
+    // старые переносятся и освобождаются
+    template <class... Args>
+    void growAndEmplaceBack(Args&&... args) {
+        size_type old_size = size();
+        pointer new_data = allocateBlock(nextCapacity(old_size + 1));
+        try {
+            std::allocator_traits<allocator_type>::construct(
+                allocator_, new_data + old_size, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocateBlock(new_data);
+            throw;
+        }
+        if (data_ != nullptr) {
+            try {
+                detail::relocate(allocator_, data_, old_size, new_data);
+            } catch (...) {
+                std::allocator_traits<allocator_type>::destroy(
+                    allocator_, new_data + old_size);
+                deallocateBlock(new_data);
+                throw;
+            }
+            deallocateBlock(data_);
+        }
+        data_ = new_data;
+        header(data_)->size = old_size + 1;
+    }
+
+    void deepClear() noexcept {
+        if (data_ != nullptr) {
+            clear();
+            deallocateBlock(data_);
+            data_ = nullptr;
+        }
+    }
+};
+
+}  // namespace my_vector
+
+namespace std {
+template <class T, class Allocator, class GrowthPolicy>
+void swap(my_vector::thin_vector<T, Allocator, GrowthPolicy>& lhs,
+          my_vector::thin_vector<T, Allocator, GrowthPolicy>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+}  // namespace std
@@ -5,19 +5,397 @@
  * cppreference.com
  */
 
+#pragma once
+
 #include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 namespace my_vector {
 
-template <class T, class Allocator = std::allocator<T>>
+/*
+ * Тип тривиально перемещаем (trivially relocatable), если перенос объекта в
+ * другое место памяти с последующим "забыванием" старой копии эквивалентен
+ * побайтовому копированию. Для тривиально копируемых типов выводится
+ * автоматически, для пользовательских типов включается специализацией:
+ *
+ *   template <>
+ *   struct my_vector::is_trivially_relocatable<MyType> : std::true_type {};
+ */
+template <class T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <class T, class Deleter>
+struct is_trivially_relocatable<std::unique_ptr<T, Deleter>>
+    : is_trivially_relocatable<Deleter> {};
+
+template <class T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+/*
+ * Политики роста ёмкости. next_capacity получает текущую ёмкость, требуемое
+ * число элементов и sizeof элемента и возвращает новую ёмкость не меньше
+ * требуемой. Политика хранится в векторе и при отсутствии состояния не
+ * занимает места.
+ */
+
+// Удвоение ёмкости
+struct doubling_growth {
+    constexpr std::size_t next_capacity(std::size_t capacity,
+                                        std::size_t required,
+                                        std::size_t) const {
+        return std::max(capacity * 2, required);
+    }
+};
+
+// Рост в 1.5 раза: освобождённые ранее блоки суммарно успевают стать больше
+// нового запроса, и аллокатор может переиспользовать их
+struct one_and_half_growth {
+    constexpr std::size_t next_capacity(std::size_t capacity,
+                                        std::size_t required,
+                                        std::size_t) const {
+        return std::max(capacity + capacity / 2, required);
+    }
+};
+
+// Удвоение с округлением размера блока вверх до целого числа страниц, как
+// только блок становится не меньше Threshold байт
+template <std::size_t PageSize = 4096, std::size_t Threshold = PageSize>
+struct page_rounded_growth {
+    static_assert((PageSize & (PageSize - 1)) == 0,
+                  "PageSize must be a power of two");
+
+    constexpr std::size_t next_capacity(std::size_t capacity,
+                                        std::size_t required,
+                                        std::size_t element_size) const {
+        std::size_t bytes = std::max(capacity * 2, required) * element_size;
+        if (bytes >= Threshold) {
+            bytes = (bytes + PageSize - 1) & ~(PageSize - 1);
+        }
+        return bytes / element_size;
+    }
+};
+
+// Размер прозрачной большой страницы (THP) на x86-64
+inline constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+// Удвоение с округлением блоков от Threshold байт до целого числа больших
+// страниц, чтобы хвост блока не оставался на обычных страницах
+template <std::size_t Threshold = huge_page_size>
+using huge_page_growth = page_rounded_growth<huge_page_size, Threshold>;
+
+// Удвоение с округлением размера блока вверх до размерного класса jemalloc:
+// 8, 16, далее с шагом 16 до 128, далее по четыре класса на каждое удвоение
+struct size_class_growth {
+    static constexpr std::size_t round_to_size_class(std::size_t bytes) {
+        if (bytes <= 8) {
+            return 8;
+        }
+        if (bytes <= 128) {
+            return (bytes + 15) & ~std::size_t{15};
+        }
+        std::size_t group = std::size_t{1}
+                            << (std::numeric_limits<std::size_t>::digits - 1 -
+                                std::countl_zero(bytes - 1));
+        std::size_t step = group / 4;
+        return (bytes + step - 1) & ~(step - 1);
+    }
+
+    constexpr std::size_t next_capacity(std::size_t capacity,
+                                        std::size_t required,
+                                        std::size_t element_size) const {
+        std::size_t bytes = std::max(capacity * 2, required) * element_size;
+        return round_to_size_class(bytes) / element_size;
+    }
+};
+
+/*
+ * Необязательные расширения аллокатора, которые вектор использует при
+ * изменении ёмкости, если они есть:
+ *
+ *   try_expand(p, old_n, new_n) -> bool
+ *     увеличивает блок p до new_n элементов без перемещения, false если
+ *     это невозможно (блок остаётся прежним);
+ *   reallocate(p, old_n, new_n) -> pointer
+ *     меняет размер блока как realloc: содержимое переносится побайтово,
+ *     при нехватке памяти бросает исключение и оставляет p нетронутым.
+ *     Вызывается только для тривиально перемещаемых элементов;
+ *   reallocate_at_least(p, old_n, new_n) -> allocation_result<pointer>
+ *     как reallocate, но возвращает и реальный размер нового блока, не
+ *     меньший new_n (ср. allocate_at_least).
+ */
+template <class Allocator>
+concept expandable_allocator =
+    requires(Allocator& allocator,
+             typename std::allocator_traits<Allocator>::pointer ptr,
+             std::size_t n) {
+        { allocator.try_expand(ptr, n, n) } -> std::convertible_to<bool>;
+    };
+
+template <class Allocator>
+concept reallocatable_allocator =
+    requires(Allocator& allocator,
+             typename std::allocator_traits<Allocator>::pointer ptr,
+             std::size_t n) {
+        {
+            allocator.reallocate(ptr, n, n)
+        } -> std::same_as<typename std::allocator_traits<Allocator>::pointer>;
+    };
+
+/*
+ * Тег конструктора из диапазона (C++23). Если стандартная библиотека его
+ * уже предоставляет, используется std::from_range_t.
+ */
+#if defined(__cpp_lib_containers_ranges)
+using std::from_range;
+using std::from_range_t;
+#else
+struct from_range_t {
+    explicit from_range_t() = default;
+};
+
+inline constexpr from_range_t from_range{};
+#endif
+
+/*
+ * Тег параллельного заполнения для конструкторов, resize и assign: элементы
+ * большого вектора конструируются в нескольких потоках. Потоки запускает сам
+ * вектор, поэтому, в отличие от std::execution::par, параллельный бэкенд
+ * стандартной библиотеки (TBB) не нужен.
+ */
+struct parallel_t {
+    explicit parallel_t() = default;
+};
+
+inline constexpr parallel_t parallel{};
+
+template <class Range, class T>
+concept container_compatible_range =
+    std::ranges::input_range<Range> and
+    std::convertible_to<std::ranges::range_reference_t<Range>, T>;
+
+/*
+ * Результат allocate_at_least (C++23). Если стандартная библиотека его уже
+ * предоставляет, используется std::allocation_result: std::allocator_traits
+ * требует, чтобы член allocate_at_least аллокатора возвращал именно его
+ */
+#if defined(__cpp_lib_allocate_at_least)
+using std::allocation_result;
+#else
+template <class Pointer, class SizeType = std::size_t>
+struct allocation_result {
+    Pointer ptr;
+    SizeType count;
+};
+#endif
+
+/*
+ * Аналог std::allocator_traits::allocate_at_least из C++23: выделяет блок
+ * не менее чем на n элементов и возвращает его реальный размер. Если
+ * стандартная библиотека его не поддерживает, используется член
+ * allocate_at_least аллокатора, а при его отсутствии обычный allocate.
+ */
+template <class Allocator>
+constexpr allocation_result<typename std::allocator_traits<Allocator>::pointer>
+allocate_at_least(Allocator& allocator, std::size_t n) {
+#if defined(__cpp_lib_allocate_at_least)
+    auto [ptr, count] =
+        std::allocator_traits<Allocator>::allocate_at_least(allocator, n);
+    return {ptr, count};
+#else
+    if constexpr (requires { allocator.allocate_at_least(n); }) {
+        auto [ptr, count] = allocator.allocate_at_least(n);
+        return {ptr, count};
+    } else {
+        return {std::allocator_traits<Allocator>::allocate(allocator, n), n};
+    }
+#endif
+}
+
+namespace detail {
+
+// Меняет размер блока через расширение reallocate и возвращает реальный
+// размер нового блока, если аллокатор его сообщает, иначе new_n
+template <reallocatable_allocator Allocator>
+constexpr allocation_result<typename std::allocator_traits<Allocator>::pointer>
+reallocate_at_least(Allocator& allocator,
+                    typename std::allocator_traits<Allocator>::pointer ptr,
+                    std::size_t n, std::size_t new_n) {
+    if constexpr (requires { allocator.reallocate_at_least(ptr, n, new_n); }) {
+        auto [new_ptr, count] = allocator.reallocate_at_least(ptr, n, new_n);
+        return {new_ptr, count};
+    } else {
+        return {allocator.reallocate(ptr, n, new_n), new_n};
+    }
+}
+
+/*
+ * Переопределяет ли аллокатор construct(ptr, args...). У
+ * std::pmr::polymorphic_allocator construct отличается от размещающего new
+ * только для типов, которым передаётся аллокатор (uses-allocator
+ * construction), поэтому для тривиально копируемых T он не считается
+ * переопределённым, и быстрые пути memcpy/инициализации по умолчанию
+ * остаются доступны pmr::vector
+ */
+template <class Allocator>
+inline constexpr bool is_polymorphic_allocator_v = false;
+
+template <class U>
+inline constexpr bool
+    is_polymorphic_allocator_v<std::pmr::polymorphic_allocator<U>> = true;
+
+template <class T, class Allocator>
+inline constexpr bool plain_polymorphic_construct =
+    is_polymorphic_allocator_v<Allocator> and
+    std::is_trivially_copyable_v<T> and
+    not std::uses_allocator_v<T, Allocator>;
+
+template <class T, class Allocator, class... Args>
+inline constexpr bool custom_construct =
+    requires(Allocator& allocator, T* ptr, Args&&... args) {
+        allocator.construct(ptr, std::forward<Args>(args)...);
+    } and not plain_polymorphic_construct<T, Allocator>;
+
+template <class T, class Allocator>
+inline constexpr bool custom_destroy =
+    requires(Allocator& allocator, T* ptr) { allocator.destroy(ptr); } and
+    not plain_polymorphic_construct<T, Allocator>;
+
+// Перенос побайтовым копированием корректен, только если T тривиально
+// перемещаем и аллокатор не переопределяет construct/destroy
+template <class T, class Allocator>
+inline constexpr bool bitwise_relocation =
+    is_trivially_relocatable_v<T> and
+    std::is_pointer_v<typename std::allocator_traits<Allocator>::pointer> and
+    not custom_construct<T, Allocator, T&&> and
+    not custom_destroy<T, Allocator>;
+
+template <class Allocator>
+constexpr void destroy_elements(
+    Allocator& allocator,
+    typename std::allocator_traits<Allocator>::pointer first,
+    std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::allocator_traits<Allocator>::destroy(allocator, first + i);
+    }
+}
+
+// Создаёт count элементов в неинициализированной памяти destination из
+// последовательных вызовов next(). При исключении созданные элементы
+// уничтожаются
+template <class Allocator, class Next>
+constexpr void construct_from(
+    Allocator& allocator,
+    typename std::allocator_traits<Allocator>::pointer destination,
+    std::size_t count, Next& next) {
+    std::size_t i = 0;
+    try {
+        for (; i < count; ++i) {
+            std::allocator_traits<Allocator>::construct(
+                allocator, destination + i, next());
+        }
+    } catch (...) {
+        destroy_elements(allocator, destination, i);
+        throw;
+    }
+}
+
+// Создаёт в неинициализированной памяти destination (не пересекающейся
+// с source) count элементов из source: перемещением, если оно не
+// бросает исключений, иначе копированием. При исключении созданные
+// элементы уничтожаются, и source остаётся нетронутым
+template <class Allocator>
+constexpr void move_if_noexcept(
+    Allocator& allocator,
+    typename std::allocator_traits<Allocator>::pointer source,
+    std::size_t count,
+    typename std::allocator_traits<Allocator>::pointer destination) {
+    auto next = [source]() mutable -> decltype(auto) {
+        return std::move_if_noexcept(*source++);
+    };
+    construct_from(allocator, destination, count, next);
+}
+
+// Переносит count элементов из source в неинициализированную память
+// destination (области не пересекаются), исходные объекты уничтожаются.
+// При исключении destination пуст, а source не изменён
+template <class Allocator>
+constexpr void relocate(
+    Allocator& allocator,
+    typename std::allocator_traits<Allocator>::pointer source,
+    std::size_t count,
+    typename std::allocator_traits<Allocator>::pointer destination) {
+    using T = typename std::allocator_traits<Allocator>::value_type;
+    if constexpr (bitwise_relocation<T, Allocator>) {
+        if (not std::is_constant_evaluated()) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(destination),
+                            static_cast<const void*>(source),
+                            count * sizeof(T));
+            }
+            return;
+        }
+    }
+    move_if_noexcept(allocator, source, count, destination);
+    destroy_elements(allocator, source, count);
+}
+
+}  // namespace detail
+
+// Память под N элементов внутри объекта, см. small_vector
+template <class T, std::size_t N>
+struct inline_storage {
+    T* data() noexcept { return reinterpret_cast<T*>(bytes); }
+
+    alignas(T) std::byte bytes[N * sizeof(T)];
+};
+
+template <class T>
+struct inline_storage<T, 0> {
+    constexpr T* data() const noexcept { return nullptr; }
+};
+
+/*
+ * При InlineCapacity > 0 первые InlineCapacity элементов размещаются внутри
+ * самого объекта, и аллокатор используется только при превышении этой
+ * ёмкости. Удобнее пользоваться псевдонимом small_vector.
+ *
+ * SizeType задаёт тип размера и ёмкости: более узкий тип уменьшает объект
+ * вектора и ограничивает max_size(), см. compact_vector.
+ */
+template <class T, class Allocator = std::allocator<T>,
+          class GrowthPolicy = doubling_growth,
+          std::size_t InlineCapacity = 0, class SizeType = std::size_t>
 class vector {
+    static_assert(InlineCapacity == 0 or
+                      std::is_pointer_v<
+                          typename std::allocator_traits<Allocator>::pointer>,
+                  "inline storage requires raw allocator pointers");
+    static_assert(std::unsigned_integral<SizeType> and
+                      sizeof(SizeType) <= sizeof(std::size_t),
+                  "SizeType must be an unsigned integer type");
+
    public:
     using value_type = T;
     using allocator_type = Allocator;
-    using size_type = std::size_t;
+    using growth_policy = GrowthPolicy;
+    using size_type = SizeType;
     using difference_type = std::ptrdiff_t;
     using reference = value_type&;
     using const_reference = const value_type&;
@@ -121,33 +499,59 @@ class vector {
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     // cppreference #1
-    constexpr vector() noexcept(noexcept(Allocator()))
-        : data_{nullptr, Allocator()} {}
+    constexpr vector() noexcept(noexcept(Allocator()) and
+                                noexcept(GrowthPolicy()))
+        : allocator_(), growth_policy_() {}
 
     // cppreference #2
     constexpr explicit vector(const Allocator& allocator) noexcept
-        : data_(nullptr, allocator) {}
+        : allocator_(allocator) {}
 
     // cppreference #3
     constexpr vector(size_t count, const T& value,
                      const Allocator& allocator = Allocator())
-        : capacity_(count), size_(count), data_(nullptr, allocator) {
-        std::get<0>(data_) = std::allocator_traits<allocator_type>::allocate(
-            std::get<1>(data_), capacity_);
+        : allocator_(allocator) {
+        allocateStorage(count);
+        size_ = count;
         for (size_t i = 0; i < size_; ++i) {
             std::allocator_traits<allocator_type>::construct(
-                std::get<1>(data_), std::get<0>(data_) + i, value);
+                allocator_, data_ + i, value);
         }
     }
 
     // cppreference #4
-    vector(size_t count, const Allocator& allocator = Allocator())
-        : capacity_(count), size_(count), data_(nullptr, allocator) {
-        std::get<0>(data_) = std::allocator_traits<allocator_type>::allocate(
-            std::get<1>(data_), capacity_);
+    constexpr vector(size_t count, const Allocator& allocator = Allocator())
+        : allocator_(allocator) {
+        allocateStorage(count);
+        size_ = count;
         for (size_t i = 0; i < size_; ++i) {
             std::allocator_traits<allocator_type>::construct(
-                std::get<1>(data_), std::get<0>(data_) + i);
+                allocator_, data_ + i);
+        }
+    }
+
+    // Параллельные варианты #3 и #4. При исключении уже созданные элементы
+    // уничтожаются, память освобождается
+    vector(parallel_t, size_t count, const T& value,
+           const Allocator& allocator = Allocator())
+        : allocator_(allocator) {
+        allocateStorage(count);
+        try {
+            parallelConstructTail(count, value);
+        } catch (...) {
+            deepClear();
+            throw;
+        }
+    }
+
+    vector(parallel_t, size_t count, const Allocator& allocator = Allocator())
+        : allocator_(allocator) {
+        allocateStorage(count);
+        try {
+            parallelConstructTail(count);
+        } catch (...) {
+            deepClear();
+            throw;
         }
     }
 
@@ -155,20 +559,18 @@ class vector {
     template <std::input_iterator InputIt>
     constexpr vector(InputIt first, InputIt last,
                      const Allocator& allocator = Allocator())
-        : data_(nullptr, allocator) {
+        : allocator_(allocator) {
         if constexpr (std::forward_iterator<InputIt> or
                       std::bidirectional_iterator<InputIt> or
                       std::random_access_iterator<InputIt>) {
-            capacity_ = std::distance(first, last);
-            size_ = capacity_;
+            auto count = std::distance(first, last);
+            allocateStorage(count);
+            size_ = count;
 
-            std::get<0>(data_) =
-                std::allocator_traits<allocator_type>::allocate(
-                    std::get<1>(data_), capacity_);
             InputIt it = first;
             for (size_t i = 0; i < size_; ++i, ++it) {
                 std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i, *it);
+                    allocator_, data_ + i, *it);
             }
         } else {
             capacity_ = 0;
@@ -187,14 +589,14 @@ class vector {
     constexpr vector(const vector& other)
         : capacity_(other.capacity_),
           size_(other.size_),
-          data_(nullptr, std::allocator_traits<Allocator>::
-                             select_on_container_copy_construction(
-                                 other.get_allocator())) {
-        std::get<0>(data_) = std::allocator_traits<allocator_type>::allocate(
-            std::get<1>(data_), capacity_);
+          allocator_(std::allocator_traits<Allocator>::
+                         select_on_container_copy_construction(
+                             other.allocator_)),
+          growth_policy_(other.growth_policy_) {
+        allocateStorage(capacity_);
         for (size_t i = 0; i < size_; ++i) {
             std::allocator_traits<allocator_type>::construct(
-                std::get<1>(data_), std::get<0>(data_) + i, other[i]);
+                allocator_, data_ + i, other[i]);
         }
     }
 
@@ -202,114 +604,194 @@ class vector {
     constexpr vector(const vector& other, const Allocator& allocator)
         : capacity_(other.capacity_),
           size_(other.size_),
-          data_(nullptr, allocator) {
-        std::get<0>(data_) = std::allocator_traits<allocator_type>::allocate(
-            std::get<1>(data_), capacity_);
+          allocator_(allocator),
+          growth_policy_(other.growth_policy_) {
+        allocateStorage(capacity_);
         for (size_t i = 0; i < size_; ++i) {
             std::allocator_traits<allocator_type>::construct(
-                std::get<1>(data_), std::get<0>(data_) + i, other[i]);
+                allocator_, data_ + i, other[i]);
         }
     }
 
     // cppreference #8
-    constexpr vector(vector&& other)
-        : capacity_(std::move(other.capacity_)),
-          size_(std::move(other.size_)),
-          data_(std::move(other.data_)) {
-        other.capacity_ = 0;
-        other.size_ = 0;
-        std::get<0>(other.data_) = nullptr;
+    constexpr vector(vector&& other) noexcept(
+        InlineCapacity == 0 or std::is_nothrow_move_constructible_v<T>)
+        : allocator_(std::move(other.allocator_)),
+          growth_policy_(std::move(other.growth_policy_)) {
+        moveFrom(other);
     }
 
-    // cppreference #9
+    // cppreference #9. Если аллокаторы не равны, элементы перемещаются по
+    // одному в память allocator; при исключении созданные элементы
+    // уничтожаются
     constexpr vector(vector&& other, const Allocator& allocator)
-        : capacity_(std::move(other.capacity_)),
-          size_(std::move(other.size_)),
-          data_(nullptr, allocator) {
-        if (allocator == other.get_allocator()) {
-            std::get<0>(data_) = std::move(std::get<0>(other.data_));
-        } else {
-            std::get<0>(data_) =
-                std::allocator_traits<allocator_type>::allocate(
-                    std::get<1>(data_), capacity_);
-            for (size_t i = 0; i < size_; ++i) {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i,
-                    std::move(other[i]));
-            }
-            other.deepClear();
+        : allocator_(allocator), growth_policy_(other.growth_policy_) {
+        if (allocator_ == other.allocator_) {
+            moveFrom(other);
+            return;
         }
-        other.capacity_ = 0;
-        other.size_ = 0;
-        std::get<0>(other.data_) = 0;
+        allocateStorage(other.size_);
+        pointer source = other.data_;
+        auto next = [&source]() -> T&& { return std::move(*source++); };
+        try {
+            constructFrom(data_, other.size_, next);
+        } catch (...) {
+            deallocateBlock(data_, capacity_);
+            throw;
+        }
+        size_ = other.size_;
+        other.deepClear();
     }
 
     // cppreference #10
     constexpr vector(std::initializer_list<T> init,
                      const Allocator& allocator = Allocator())
-        : capacity_(init.size()),
-          size_(init.size()),
-          data_(nullptr, allocator) {
-        std::get<0>(data_) = std::allocator_traits<allocator_type>::allocate(
-            std::get<1>(data_), capacity_);
+        : allocator_(allocator) {
+        allocateStorage(init.size());
+        size_ = init.size();
         auto it = init.begin();
         for (size_t i = 0; i < size_; ++i, ++it) {
             std::allocator_traits<allocator_type>::construct(
-                std::get<1>(data_), std::get<0>(data_) + i, *it);
+                allocator_, data_ + i, *it);
+        }
+    }
+
+    template <container_compatible_range<T> Range>
+    constexpr vector(from_range_t, Range&& range,
+                     const Allocator& allocator = Allocator())
+        : allocator_(allocator) {
+        try {
+            append_range(std::forward<Range>(range));
+        } catch (...) {
+            deepClear();
+            throw;
         }
     }
 
     constexpr ~vector() { deepClear(); }
 
     constexpr vector& operator=(const vector& other) {
-        vector new_vector(other);
-        swap(new_vector);
+        if (this == &other) {
+            return *this;
+        }
+        if constexpr (std::allocator_traits<allocator_type>::
+                          propagate_on_container_copy_assignment::value) {
+            if (get_allocator() != other.get_allocator()) {
+                deepClear();
+            }
+            allocator_ = other.get_allocator();
+        }
+        growth_policy_ = other.get_growth_policy();
+        assignFrom(other.data(), other.size_);
         return *this;
     }
 
     constexpr vector& operator=(vector&& other) noexcept(
-        std::allocator_traits<
-            Allocator>::propagate_on_container_move_assignment::value or
-        std::allocator_traits<Allocator>::is_always_equal::value) {
-        if constexpr (std::allocator_traits<allocator_type>::
-                          propagate_on_container_move_assignment::value) {
-            vector new_vector(std::move(other), other.get_allocator());
-            swap(new_vector);
-        } else {
-            if (get_allocator() != other.get_allocator()) {
-                vector new_vector(std::move(other), get_allocator());
-                swap(new_vector);
-            } else {
-                vector new_vector(std::move(other));
-                swap(new_vector);
+        (std::allocator_traits<
+             Allocator>::propagate_on_container_move_assignment::value or
+         std::allocator_traits<Allocator>::is_always_equal::value) and
+        (InlineCapacity == 0 or std::is_nothrow_move_constructible_v<T>)) {
+        if (this == &other) {
+            return *this;
+        }
+        constexpr bool propagate = std::allocator_traits<
+            allocator_type>::propagate_on_container_move_assignment::value;
+        if (propagate or allocator_ == other.allocator_) {
+            deepClear();
+            if constexpr (propagate) {
+                allocator_ = other.allocator_;
             }
+            growth_policy_ = other.growth_policy_;
+            moveFrom(other);
+        } else {
+            // память other не может быть освобождена нашим аллокатором,
+            // элементы перемещаются по одному
+            vector new_vector(std::move(other), allocator_);
+            swap(new_vector);
         }
         return *this;
     }
 
     constexpr vector& operator=(std::initializer_list<T> init) {
-        vector new_vector(init, std::get<1>(data_));
-        swap(new_vector);
+        assign(init);
         return *this;
     }
 
     constexpr void assign(size_type count, const T& value) {
-        vector new_vector(count, value, std::get<1>(data_));
-        swap(new_vector);
+        assignCount(count, [&value]() -> const T& { return value; });
+    }
+
+    // Перезапись и конструирование элементов делятся между потоками. Если
+    // нужна новая память, гарантия строгая, иначе при исключении часть
+    // элементов может быть уже перезаписана
+    void assign(parallel_t, size_type count, const T& value) {
+        if (count > capacity_) {
+            vector fresh(parallel, count, value, allocator_);
+            deepClear();
+            moveFrom(fresh);
+        } else {
+            // другие потоки не должны читать value, пока он перезаписывается
+            std::optional<T> copy;
+            const T* source = std::addressof(value);
+            if (isElement(source)) {
+                copy.emplace(value);
+                source = std::addressof(*copy);
+            }
+            size_type common = std::min(count, size_);
+            T* ptr = std::to_address(data_);
+            std::exception_ptr error =
+                firstError(runChunks(0, common, [ptr, source](size_type begin,
+                                                              size_type end) {
+                    std::fill(ptr + begin, ptr + end, *source);
+                }));
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            if (count > size_) {
+                parallelConstructTail(count, *source);
+            } else {
+                destroyTail(count);
+            }
+        }
     }
 
     template <std::input_iterator InputIt>
     constexpr void assign(InputIt first, InputIt last) {
-        vector new_vector(first, last, std::get<1>(data_));
-        swap(new_vector);
+        if constexpr (std::forward_iterator<InputIt>) {
+            assignFrom(first, std::distance(first, last));
+        } else {
+            pointer ptr = data_;
+            size_type i = 0;
+            for (; i < size_ and first != last; ++i, ++first) {
+                ptr[i] = *first;
+            }
+            destroyTail(i);
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
     }
 
     constexpr void assign(std::initializer_list<T> init) {
-        vector new_vector(init, std::get<1>(data_));
-        swap(new_vector);
+        assignFrom(init.begin(), init.size());
+    }
+
+    template <container_compatible_range<T> Range>
+    constexpr void assign_range(Range&& range) {
+        if constexpr (std::ranges::forward_range<Range> or
+                      std::ranges::sized_range<Range>) {
+            assignFrom(std::ranges::begin(range), std::ranges::distance(range));
+        } else {
+            clear();
+            append_range(std::forward<Range>(range));
+        }
     }
 
-    constexpr Allocator get_allocator() const { return std::get<1>(data_); }
+    constexpr Allocator get_allocator() const { return allocator_; }
+
+    constexpr GrowthPolicy get_growth_policy() const {
+        return growth_policy_;
+    }
 
     // =============================
     // Element access (cppreference)
@@ -318,60 +800,60 @@ class vector {
         if (position >= size_) {
             throw std::out_of_range("Index is out of vector size");
         }
-        return std::get<0>(data_)[position];
+        return data_[position];
     }
 
     constexpr const T& at(size_t position) const {
         if (position >= size_) {
             throw std::out_of_range("Index is out of vector size");
         }
-        return std::get<0>(data_)[position];
+        return data_[position];
     }
 
     constexpr T& operator[](size_t position) {
-        return std::get<0>(data_)[position];
+        return data_[position];
     }
 
     constexpr const T& operator[](size_t position) const {
-        return std::get<0>(data_)[position];
+        return data_[position];
     }
 
-    constexpr T& front() { return std::get<0>(data_)[0]; }
+    constexpr T& front() { return data_[0]; }
 
-    constexpr const T& front() const { return std::get<0>(data_)[0]; }
+    constexpr const T& front() const { return data_[0]; }
 
-    constexpr T& back() { return std::get<0>(data_)[size_ - 1]; }
+    constexpr T& back() { return data_[size_ - 1]; }
 
-    constexpr const T& back() const { return std::get<0>(data_)[size_ - 1]; }
+    constexpr const T& back() const { return data_[size_ - 1]; }
 
-    T* data() { return std::get<0>(data_); }
+    constexpr T* data() noexcept { return data_; }
 
-    const T* data() const { return std::get<0>(data_); }
+    constexpr const T* data() const noexcept { return data_; }
 
     // ========================
     // Iterators (cppreference)
     // ========================
 
-    constexpr iterator begin() noexcept { return iterator(std::get<0>(data_)); }
+    constexpr iterator begin() noexcept { return iterator(data_); }
 
     constexpr const_iterator begin() const noexcept {
-        return const_iterator(std::get<0>(data_));
+        return const_iterator(data_);
     }
 
     constexpr const_iterator cbegin() const noexcept {
-        return const_iterator(std::get<0>(data_));
+        return const_iterator(data_);
     }
 
     constexpr iterator end() noexcept {
-        return iterator(std::get<0>(data_) + size_);
+        return iterator(data_ + size_);
     }
 
     constexpr const_iterator end() const noexcept {
-        return const_iterator(std::get<0>(data_) + size_);
+        return const_iterator(data_ + size_);
     }
 
     constexpr const_iterator cend() const noexcept {
-        return const_iterator(std::get<0>(data_) + size_);
+        return const_iterator(data_ + size_);
     }
 
     constexpr reverse_iterator rbegin() noexcept {
@@ -404,12 +886,16 @@ class vector {
 
     constexpr bool empty() const { return size_ == 0; }
 
-    constexpr size_t size() const { return size_; }
+    constexpr size_type size() const { return size_; }
 
-    constexpr size_t max_size() const {
-        return std::allocator_traits<allocator_type>::max_size(
-                   std::get<1>(data_)) /
-               sizeof(T);
+    // Ограничен и аллокатором, и диапазоном size_type
+    constexpr size_type max_size() const {
+        std::size_t allocator_max =
+            std::allocator_traits<allocator_type>::max_size(
+                allocator_) /
+            sizeof(T);
+        return static_cast<size_type>(std::min<std::size_t>(
+            allocator_max, std::numeric_limits<size_type>::max()));
     }
 
     constexpr void reserve(size_t new_capacity) {
@@ -421,7 +907,18 @@ class vector {
         }
     }
 
-    constexpr size_t capacity() const { return capacity_; }
+    // Элементы переносятся в новый блок в нескольких потоках, см.
+    // resize(parallel_t, ...)
+    void reserve(parallel_t, size_t new_capacity) {
+        if (new_capacity > max_size()) {
+            throw std::length_error("");
+        }
+        if (new_capacity > capacity_) {
+            reallocate<true>(new_capacity);
+        }
+    }
+
+    constexpr size_type capacity() const { return capacity_; }
 
     constexpr void shrink_to_fit() {
         if (capacity_ > size_) {
@@ -433,417 +930,978 @@ class vector {
     // Modifiers (cppreference)
     // ========================
 
-    constexpr void clear() {
-        for (size_t i = 0; i < size_; ++i) {
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i);
-        }
-        size_ = 0;
-    }
+    constexpr void clear() { destroyTail(0); }
 
     constexpr iterator insert(const_iterator position, const T& value) {
-        if (size_ == capacity_) {
-            if (capacity_ == 0) {
-                reallocate(1);
-            } else {
-                reallocate(capacity_ * 2);
+        return emplace(position, value);
+    }
+
+    constexpr iterator insert(const_iterator position, T&& value) {
+        return emplace(position, std::move(value));
+    }
+
+    constexpr iterator insert(const_iterator position, size_type count,
+                              const T& value) {
+        size_type insert_index =
+            std::distance(data_, position.base());
+        if (isElement(std::addressof(value))) {
+            // сдвиг хвоста или перевыделение испортили бы value
+            T copy(value);
+            return insertCount(insert_index, count,
+                               [&copy]() -> const T& { return copy; });
+        }
+        return insertCount(insert_index, count,
+                           [&value]() -> const T& { return value; });
+    }
+
+    template <std::input_iterator InputIt>
+    constexpr iterator insert(const_iterator position, InputIt first,
+                              InputIt last) {
+        size_type insert_index =
+            std::distance(data_, position.base());
+        if constexpr (std::forward_iterator<InputIt>) {
+            return insertCount(
+                insert_index, std::distance(first, last),
+                [&first]() -> decltype(auto) { return *first++; });
+        } else {
+            // длина диапазона заранее неизвестна: дописываем в конец и
+            // поворачиваем
+            size_type old_size = size_;
+            for (; first != last; ++first) {
+                emplace_back(*first);
             }
+            std::rotate(begin() + insert_index, begin() + old_size, end());
+            return begin() + insert_index;
         }
+    }
+
+    constexpr iterator insert(const_iterator position,
+                              std::initializer_list<T> init) {
+        return insert(position, init.begin(), init.end());
+    }
+
+    // Для диапазонов известной длины память выделяется один раз, смежные
+    // диапазоны тривиально копируемых элементов копируются memcpy
+    template <container_compatible_range<T> Range>
+    constexpr iterator insert_range(const_iterator position, Range&& range) {
         size_type insert_index =
-            std::distance(std::get<0>(data_), position.base());
-        for (size_type i = size_ - 1; i >= insert_index; --i) {
-            if constexpr (std::is_move_constructible_v<value_type>) {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + 1,
-                    std::move(std::get<0>(data_)[i]));
-            } else {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + 1,
-                    std::get<0>(data_)[i]);
+            std::distance(data_, position.base());
+        if constexpr (std::ranges::forward_range<Range> or
+                      std::ranges::sized_range<Range>) {
+            size_type count = std::ranges::distance(range);
+            if constexpr (std::ranges::contiguous_range<Range> and
+                          std::same_as<std::ranges::range_value_t<Range>, T> and
+                          bitwise_copy) {
+                if (not std::is_constant_evaluated()) {
+                    return insertBitwise(insert_index,
+                                         std::ranges::data(range), count);
+                }
             }
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i);
+            return insertCount(insert_index, count,
+                               [it = std::ranges::begin(range)]() mutable
+                               -> decltype(auto) { return *it++; });
+        } else {
+            size_type old_size = size_;
+            for (auto&& element : range) {
+                emplace_back(std::forward<decltype(element)>(element));
+            }
+            std::rotate(begin() + insert_index, begin() + old_size, end());
+            return begin() + insert_index;
         }
-        std::allocator_traits<allocator_type>::construct(
-            std::get<1>(data_), std::get<0>(data_) + insert_index, value);
-        ++size_;
-        return iterator(std::get<0>(data_) + insert_index);
     }
 
-    constexpr iterator insert(const_iterator position, T&& value) {
+    template <container_compatible_range<T> Range>
+    constexpr void append_range(Range&& range) {
+        insert_range(end(), std::forward<Range>(range));
+    }
+
+    template <class... Args>
+    constexpr iterator emplace(const_iterator position, Args&&... args) {
+        size_type insert_index =
+            std::distance(data_, position.base());
+        if (insert_index == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(data_ + insert_index);
+        }
         if (size_ == capacity_) {
-            if (capacity_ == 0) {
-                reallocate(1);
-            } else {
-                reallocate(capacity_ * 2);
+            size_type new_capacity = nextCapacity(std::size_t{size_} + 1);
+            if (not expandInPlace(new_capacity)) {
+                insertWithGrowth(
+                    insert_index, 1, new_capacity, [&](pointer destination) {
+                        std::allocator_traits<allocator_type>::construct(
+                            allocator_, destination,
+                            std::forward<Args>(args)...);
+                    });
+                return iterator(data_ + insert_index);
             }
         }
-        size_type insert_index =
-            std::distance(std::get<0>(data_), position.base());
-        for (size_type i = size_ - 1; i >= insert_index; --i) {
-            if constexpr (std::is_move_constructible_v<value_type>) {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + 1,
-                    std::move(std::get<0>(data_)[i]));
-            } else {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + 1,
-                    std::get<0>(data_)[i]);
-            }
+        T value(std::forward<Args>(args)...);
+        auto next = [&value]() -> T&& { return std::move(value); };
+        insertInPlace(insert_index, 1, next);
+        return iterator(data_ + insert_index);
+    }
+
+    constexpr iterator erase(const_iterator position) {
+        size_type erase_index =
+            std::distance(data_, position.base());
+        std::allocator_traits<allocator_type>::destroy(
+            allocator_, data_ + erase_index);
+        shiftLeft(erase_index + 1, 1);
+        --size_;
+        return iterator(data_ + erase_index);
+    }
 
+    constexpr iterator erase(const_iterator first, const_iterator last) {
+        if (first == last) {
+            return iterator(last.base());
+        }
+        size_type erase_index = std::distance(data_, first.base());
+        size_type count = std::distance(first, last);
+        for (size_type i = 0; i < count; ++i) {
             std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i);
+                allocator_, data_ + erase_index + i);
+        }
+        shiftLeft(erase_index + count, count);
+        size_ -= count;
+        return iterator(data_ + erase_index);
+    }
+
+    constexpr void push_back(const T& value) { emplace_back(value); }
+
+    constexpr void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <class... Args>
+    constexpr reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            growAndEmplaceBack(std::forward<Args>(args)...);
+        } else {
+            std::allocator_traits<allocator_type>::construct(
+                allocator_, data_ + size_, std::forward<Args>(args)...);
+            ++size_;
         }
+        return back();
+    }
 
-        std::allocator_traits<allocator_type>::construct(
-            std::get<1>(data_), std::get<0>(data_) + insert_index,
-            std::move(value));
-        ++size_;
-        return iterator(std::get<0>(data_) + insert_index);
+    constexpr void pop_back() {
+        --size_;
+        std::allocator_traits<allocator_type>::destroy(
+            allocator_, data_ + size_);
     }
 
-    constexpr iterator insert(const_iterator position, size_type count,
-                              const T& value) {
-        if (count == 0) {
-            return iterator(position.base());
+    constexpr void resize(size_type count) {
+        resizeImpl<false>(count);
+    }
+
+    constexpr void resize(size_type count, const T& value) {
+        resizeImpl<false>(count, value);
+    }
+
+    // Новые элементы конструируются в нескольких потоках; при исключении
+    // вектор не меняется, кроме ёмкости
+    void resize(parallel_t, size_type count) { resizeImpl<true>(count); }
+
+    void resize(parallel_t, size_type count, const T& value) {
+        resizeImpl<true>(count, value);
+    }
+
+    // Как resize, но новые элементы инициализируются по умолчанию, а не по
+    // значению: для тривиальных типов память не заполняется
+    constexpr void resize_default_init(size_type count) {
+        if (count <= size_) {
+            destroyTail(count);
+            return;
         }
-        if (size_ + count > capacity_) {
-            if (capacity_ == 0) {
-                reallocate(count);
-            } else {
-                reallocate(std::max(capacity_ * 2, size_ + count));
-            }
+        if (count > capacity_) {
+            reallocate(nextCapacity(count));
         }
-        size_type insert_index =
-            std::distance(std::get<0>(data_), position.base());
-        for (size_type i = size_ - 1; i >= insert_index; --i) {
-            if constexpr (std::is_move_constructible_v<value_type>) {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + count,
-                    std::move(std::get<0>(data_)[i]));
-            } else {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + count,
-                    std::get<0>(data_)[i]);
-            }
+        defaultConstructTail(count);
+    }
 
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i);
+    // Аналог std::string::resize_and_overwrite: вектор расширяется до count
+    // элементов (новые инициализируются по умолчанию), после чего
+    // operation(data(), count) заполняет буфер и возвращает число
+    // действительных элементов, не большее count
+    template <class Operation>
+    constexpr void resize_and_overwrite(size_type count, Operation operation) {
+        resize_default_init(count);
+        size_type new_size = std::move(operation)(data(), count);
+        destroyTail(new_size);
+    }
+
+    // Добавляет count элементов, которые operation(data() + size(), count)
+    // конструирует в неинициализированной памяти за последним элементом.
+    // Если operation бросает исключение, созданные ею элементы она уничтожает
+    // сама, а вектор не меняется, кроме ёмкости
+    template <class Operation>
+    constexpr void append_uninitialized(size_type count, Operation operation) {
+        if (count > max_size() - size_) {
+            throw std::length_error("");
         }
-        for (size_type i = 0; i < count; ++i) {
-            std::allocator_traits<allocator_type>::construct(
-                std::get<1>(data_), std::get<0>(data_) + insert_index + i,
-                value);
+        if (size_ + count > capacity_) {
+            reallocate(nextCapacity(size_ + count));
         }
+        std::move(operation)(data() + size_, count);
         size_ += count;
-        return iterator(std::get<0>(data_) + insert_index);
     }
 
-    template <class InputIt>
-    constexpr iterator insert(const_iterator position, InputIt first,
-                              InputIt last) {
-        if (first == last) {
-            return iterator(position.base());
+    constexpr void swap(vector& other) noexcept(
+        (std::allocator_traits<
+             Allocator>::propagate_on_container_swap::value or
+         std::allocator_traits<Allocator>::is_always_equal::value) and
+        (InlineCapacity == 0 or std::is_nothrow_move_constructible_v<T>)) {
+        if (isInline(data_) or
+            other.isInline(other.data_)) {
+            // встроенный буфер нельзя передать, элементы переносятся
+            vector temporary(std::move(other));
+            other.moveFrom(*this);
+            moveFrom(temporary);
+        } else {
+            std::swap(capacity_, other.capacity_);
+            std::swap(size_, other.size_);
+            std::swap(data_, other.data_);
         }
-        size_type count = std::distance(first, last);
-        if (size_ + count > capacity_) {
-            if (capacity_ == 0) {
-                reallocate(count);
-            } else {
-                reallocate(std::max(capacity_ * 2, size_ + count));
-            }
+        if constexpr (std::allocator_traits<
+                          allocator_type>::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(allocator_, other.allocator_);
         }
-        size_type insert_index =
-            std::distance(std::get<0>(data_), position.base());
-        for (size_type i = size_ - 1; i >= insert_index; --i) {
-            if constexpr (std::is_move_constructible_v<value_type>) {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + count,
-                    std::move(std::get<0>(data_)[i]));
-            } else {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + count,
-                    std::get<0>(data_)[i]);
-            }
+        std::swap(growth_policy_, other.growth_policy_);
+    }
 
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i);
+   private:
+    size_type capacity_{0};
+    size_type size_{0};
+    pointer data_{nullptr};
+    [[no_unique_address]] allocator_type allocator_;
+    [[no_unique_address]] growth_policy growth_policy_;
+    [[no_unique_address]] inline_storage<T, InlineCapacity> inline_;
+
+    constexpr bool isInline(pointer ptr) const {
+        if constexpr (InlineCapacity == 0) {
+            return false;
+        } else {
+            return ptr == const_cast<vector*>(this)->inline_.data();
         }
-        InputIt it = first;
-        for (size_type i = 0; i < count; ++i, ++it) {
-            std::allocator_traits<allocator_type>::construct(
-                std::get<1>(data_), std::get<0>(data_) + insert_index + i, *it);
+    }
+
+    // Забирает содержимое other, сам вектор должен быть без буфера. Из
+    // встроенного буфера other элементы переносятся поштучно
+    constexpr void moveFrom(vector& other) {
+        pointer other_ptr = other.data_;
+        if (other.isInline(other_ptr)) {
+            data_ = inline_.data();
+            capacity_ = InlineCapacity;
+            relocate(other_ptr, other.size_, data_);
+        } else {
+            data_ = other_ptr;
+            capacity_ = other.capacity_;
         }
-        size_ += count;
-        return iterator(std::get<0>(data_) + insert_index);
+        size_ = other.size_;
+        other.capacity_ = 0;
+        other.size_ = 0;
+        other.data_ = nullptr;
     }
 
-    constexpr iterator insert(const_iterator position,
-                              std::initializer_list<T> init) {
-        if (init.empty()) {
-            return iterator(position.base());
+    // Выделяет блок не менее чем на count элементов; встроенный буфер
+    // используется, если он свободен и его хватает. Ёмкость сверх max_size()
+    // не учитывается, чтобы она помещалась в size_type
+    constexpr allocation_result<pointer, size_type> allocateBlock(
+        size_type count) {
+        if constexpr (InlineCapacity != 0) {
+            if (count <= InlineCapacity and not isInline(data_)) {
+                return {inline_.data(), InlineCapacity};
+            }
         }
-        size_type count = init.size();
-        if (size_ + count > capacity_) {
-            if (capacity_ == 0) {
-                reallocate(count);
-            } else {
-                reallocate(std::max(capacity_ * 2, size_ + count));
+        auto [ptr, allocated] =
+            my_vector::allocate_at_least(allocator_, count);
+        return {ptr, static_cast<size_type>(
+                         std::min<std::size_t>(allocated, max_size()))};
+    }
+
+    constexpr void deallocateBlock(pointer ptr, size_type count) {
+        if (ptr != nullptr and not isInline(ptr)) {
+            std::allocator_traits<allocator_type>::deallocate(
+                allocator_, ptr, count);
+        }
+    }
+
+    // Ёмкость, которую следует выделить, чтобы вместить required элементов
+    constexpr size_type nextCapacity(std::size_t required) const {
+        if (required > max_size()) {
+            throw std::length_error("");
+        }
+        std::size_t new_capacity =
+            growth_policy_.next_capacity(capacity_, required, sizeof(T));
+        return static_cast<size_type>(std::clamp<std::size_t>(
+            new_capacity, required, max_size()));
+    }
+
+    static constexpr bool bitwise_relocation =
+        detail::bitwise_relocation<T, allocator_type>;
+
+    // Копирование memcpy корректно для тривиально копируемых T, если
+    // аллокатор не переопределяет construct
+    static constexpr bool bitwise_copy =
+        std::is_trivially_copyable_v<T> and std::is_pointer_v<pointer> and
+        not detail::custom_construct<T, allocator_type, const T&>;
+
+    // См. detail::move_if_noexcept
+    constexpr void moveIfNoexcept(pointer source, size_type count,
+                                  pointer destination) {
+        detail::move_if_noexcept(allocator_, source, count,
+                                 destination);
+    }
+
+    constexpr void destroyElements(pointer first, size_type count) {
+        detail::destroy_elements(allocator_, first, count);
+    }
+
+    // См. detail::relocate
+    constexpr void relocate(pointer source, size_type count,
+                            pointer destination) {
+        detail::relocate(allocator_, source, count, destination);
+    }
+
+    // Сдвигает элементы [index, size_) на count позиций вправо, оставляя
+    // на месте [index, index + count) неинициализированную память
+    constexpr void shiftRight(size_type index, size_type count) {
+        pointer ptr = data_;
+        if constexpr (bitwise_relocation) {
+            if (not std::is_constant_evaluated()) {
+                if (size_ != index) {
+                    std::memmove(static_cast<void*>(ptr + index + count),
+                                 static_cast<const void*>(ptr + index),
+                                 (size_ - index) * sizeof(T));
+                }
+                return;
             }
         }
-        size_type insert_index =
-            std::distance(std::get<0>(data_), position.base());
-        for (size_type i = size_ - 1; i >= insert_index; --i) {
+        for (size_type i = size_; i > index; --i) {
             if constexpr (std::is_move_constructible_v<value_type>) {
                 std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + count,
-                    std::move(std::get<0>(data_)[i]));
+                    allocator_, ptr + i - 1 + count,
+                    std::move(ptr[i - 1]));
             } else {
                 std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + count,
-                    std::get<0>(data_)[i]);
+                    allocator_, ptr + i - 1 + count, ptr[i - 1]);
             }
-
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i);
+            std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                           ptr + i - 1);
         }
-        auto it = init.begin();
-        for (size_type i = 0; i < count; ++i, ++it) {
-            std::allocator_traits<allocator_type>::construct(
-                std::get<1>(data_), std::get<0>(data_) + insert_index + i, *it);
-        }
-        size_ += count;
-        return iterator(std::get<0>(data_) + insert_index);
     }
 
-    template <class... Args>
-    constexpr iterator emplace(const_iterator position, Args&&... args) {
-        if (size_ == capacity_) {
-            if (capacity_ == 0) {
-                reallocate(1);
-            } else {
-                reallocate(capacity_ * 2);
+    // Сдвигает элементы [index, size_) на count позиций влево, память
+    // [index - count, index) должна быть уже освобождена от объектов
+    constexpr void shiftLeft(size_type index, size_type count) {
+        pointer ptr = data_;
+        if constexpr (bitwise_relocation) {
+            if (not std::is_constant_evaluated()) {
+                if (size_ != index) {
+                    std::memmove(static_cast<void*>(ptr + index - count),
+                                 static_cast<const void*>(ptr + index),
+                                 (size_ - index) * sizeof(T));
+                }
+                return;
             }
         }
-        size_type insert_index =
-            std::distance(std::get<0>(data_), position.base());
-        for (size_type i = size_ - 1; i >= insert_index; --i) {
+        for (size_type i = index; i < size_; ++i) {
             if constexpr (std::is_move_constructible_v<value_type>) {
                 std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + 1,
-                    std::move(std::get<0>(data_)[i]));
+                    allocator_, ptr + i - count, std::move(ptr[i]));
             } else {
                 std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i + 1,
-                    std::get<0>(data_)[i]);
+                    allocator_, ptr + i - count, ptr[i]);
             }
+            std::allocator_traits<allocator_type>::destroy(allocator_,
+                                                           ptr + i);
+        }
+    }
 
+    // Уничтожает элементы [new_size, size_)
+    constexpr void destroyTail(size_type new_size) {
+        for (size_type i = new_size; i < size_; ++i) {
             std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i);
+                allocator_, data_ + i);
         }
-        std::allocator_traits<allocator_type>::construct(
-            std::get<1>(data_), std::get<0>(data_) + insert_index,
-            std::forward<Args>(args)...);
-        ++size_;
-        return iterator(std::get<0>(data_) + insert_index);
+        size_ = new_size;
     }
 
-    constexpr iterator erase(const_iterator position) {
-        size_type erase_index =
-            std::distance(std::get<0>(data_), position.base());
-        std::allocator_traits<allocator_type>::destroy(
-            std::get<1>(data_), std::get<0>(data_) + erase_index);
-        --size_;
-        for (size_type i = erase_index; i < size_; ++i) {
-            if constexpr (std::is_move_constructible_v<value_type>) {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i,
-                    std::move(std::get<0>(data_)[i + 1]));
-            } else {
+    // Конструирует элементы [size_, new_size) из args, ёмкость должна быть
+    // достаточной. При исключении созданные элементы уничтожаются и размер
+    // не меняется
+    template <class... Args>
+    constexpr void constructTail(size_type new_size, const Args&... args) {
+        pointer ptr = data_;
+        size_type i = size_;
+        try {
+            for (; i < new_size; ++i) {
                 std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i,
-                    std::get<0>(data_)[i + 1]);
+                    allocator_, ptr + i, args...);
+            }
+        } catch (...) {
+            for (; i > size_; --i) {
+                std::allocator_traits<allocator_type>::destroy(
+                    allocator_, ptr + i - 1);
             }
+            throw;
+        }
+        size_ = new_size;
+    }
 
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i + 1);
+    // Элементов меньшего суммарного размера (в байтах) на поток не хватает,
+    // чтобы окупить его запуск
+    static constexpr std::size_t parallel_chunk_bytes = 1 << 20;
+
+    // На сколько частей делить count элементов при параллельной обработке
+    static size_type parallelChunks(size_type count) {
+        std::size_t by_size = count / std::max<std::size_t>(
+                                          1, parallel_chunk_bytes / sizeof(T));
+        std::size_t threads = std::thread::hardware_concurrency();
+        return std::max<std::size_t>(1, std::min(by_size, threads));
+    }
+
+    // Границы части chunk из chunks при делении [first, last)
+    static std::pair<size_type, size_type> chunkBounds(size_type first,
+                                                       size_type last,
+                                                       size_type chunk,
+                                                       size_type chunks) {
+        // первые count % chunks частей на один элемент длиннее
+        size_type step = (last - first) / chunks;
+        size_type extra = (last - first) % chunks;
+        return {first + step * chunk + std::min(chunk, extra),
+                first + step * (chunk + 1) + std::min(chunk + 1, extra)};
+    }
+
+    /*
+     * Выполняет operation(begin, end) для частей [first, last): первую в
+     * вызывающем потоке, остальные в новых. Если поток создать не удалось,
+     * часть обрабатывается в вызывающем. Возвращает исключения, брошенные
+     * каждой из частей
+     */
+    template <class Operation>
+    static vector<std::exception_ptr> runChunks(size_type first,
+                                                size_type last,
+                                                Operation operation) {
+        size_type chunks = parallelChunks(last - first);
+        vector<std::exception_ptr> errors(chunks);
+        auto run = [&](size_type chunk) {
+            auto [begin, end] = chunkBounds(first, last, chunk, chunks);
+            try {
+                operation(begin, end);
+            } catch (...) {
+                errors[chunk] = std::current_exception();
+            }
+        };
+        vector<std::thread> workers;
+        for (size_type chunk = 1; chunk < chunks; ++chunk) {
+            try {
+                workers.emplace_back(run, chunk);
+            } catch (...) {
+                run(chunk);
+            }
         }
-        return iterator(std::get<0>(data_) + erase_index);
+        run(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        return errors;
     }
 
-    constexpr iterator erase(const_iterator first, const_iterator last) {
-        if (first == last) {
-            return iterator(last.base());
+    static std::exception_ptr firstError(
+        const vector<std::exception_ptr>& errors) {
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                return error;
+            }
         }
-        size_type erase_index = std::distance(std::get<0>(data_), first.base());
-        size_type count = std::distance(first, last);
-        for (size_type i = 0; i < count; ++i) {
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + erase_index + i);
+        return nullptr;
+    }
+
+    /*
+     * Побайтово переносит элементы в new_data частями в разных потоках. Поток
+     * первым касается страниц своей части нового блока, поэтому при
+     * размещении по первому касанию (политика NUMA local) они оказываются
+     * на узле потока, который будет обрабатывать эти элементы при тех же
+     * границах частей
+     */
+    void parallelRelocate(pointer new_data) {
+        const T* source = std::to_address(data_);
+        T* destination = std::to_address(new_data);
+        runChunks(0, size_, [source, destination](size_type begin,
+                                                  size_type end) {
+            std::memcpy(static_cast<void*>(destination + begin),
+                        static_cast<const void*>(source + begin),
+                        (end - begin) * sizeof(T));
+        });
+    }
+
+    /*
+     * constructTail, в котором части [size_, new_size) конструируются в
+     * разных потоках. Каждая часть при исключении уничтожает свои элементы,
+     * после чего уничтожаются успешно созданные части, и первое исключение
+     * передаётся дальше. Если аллокатор переопределяет construct или
+     * элементов мало, конструирование последовательное
+     */
+    template <class... Args>
+    void parallelConstructTail(size_type new_size, const Args&... args) {
+        constexpr bool custom_construct =
+            detail::custom_construct<T, allocator_type, const Args&...>;
+        size_type first = size_;
+        if (custom_construct or parallelChunks(new_size - first) <= 1) {
+            constructTail(new_size, args...);
+            return;
         }
-        size_ -= count;
-        for (size_type i = erase_index; i < size_; ++i) {
-            if constexpr (std::is_move_constructible_v<value_type>) {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i,
-                    std::move(std::get<0>(data_)[i + count]));
-            } else {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), std::get<0>(data_) + i,
-                    std::get<0>(data_)[i + count]);
+        T* ptr = std::to_address(data_);
+        vector<std::exception_ptr> errors = runChunks(
+            first, new_size, [ptr, &args...](size_type begin, size_type end) {
+                if constexpr (sizeof...(Args) == 0) {
+                    std::uninitialized_value_construct(ptr + begin, ptr + end);
+                } else {
+                    std::uninitialized_fill(ptr + begin, ptr + end, args...);
+                }
+            });
+        if (std::exception_ptr error = firstError(errors)) {
+            for (size_type chunk = 0; chunk < errors.size(); ++chunk) {
+                if (not errors[chunk]) {
+                    auto [begin, end] =
+                        chunkBounds(first, new_size, chunk, errors.size());
+                    std::destroy(ptr + begin, ptr + end);
+                }
             }
+            std::rethrow_exception(error);
+        }
+        size_ = new_size;
+    }
 
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i + count);
+    template <bool Parallel, class... Args>
+    constexpr void constructTailWith(size_type new_size, const Args&... args) {
+        if constexpr (Parallel) {
+            parallelConstructTail(new_size, args...);
+        } else {
+            constructTail(new_size, args...);
         }
-        return iterator(std::get<0>(data_) + erase_index);
     }
 
-    constexpr void push_back(const T& value) {
-        if (size_ == capacity_) {
-            if (capacity_ == 0) {
-                reallocate(1);
+    // Общая часть resize: value пуст для инициализации значением или
+    // содержит один элемент-образец
+    template <bool Parallel, class... Args>
+    constexpr void resizeImpl(size_type count, const Args&... value) {
+        if (count <= size_) {
+            destroyTail(count);
+            return;
+        }
+        if (count > capacity_) {
+            if constexpr (sizeof...(Args) == 0) {
+                reallocate<Parallel>(nextCapacity(count));
             } else {
-                reallocate(capacity_ * 2);
+                // value может ссылаться на элемент самого вектора, после
+                // перевыделения он окажется по тому же индексу
+                const T* source = std::addressof(value...);
+                bool is_element = isElement(source);
+                size_type index =
+                    is_element ? source - std::to_address(data_) : 0;
+                reallocate<Parallel>(nextCapacity(count));
+                if (is_element) {
+                    source = std::to_address(data_) + index;
+                }
+                constructTailWith<Parallel>(count, *source);
+                return;
             }
         }
-
-        std::allocator_traits<allocator_type>::construct(
-            std::get<1>(data_), std::get<0>(data_) + size_, value);
-        ++size_;
+        constructTailWith<Parallel>(count, value...);
     }
 
-    constexpr void push_back(T&& value) {
-        if (size_ == capacity_) {
-            if (capacity_ == 0) {
-                reallocate(1);
-            } else {
-                reallocate(capacity_ * 2);
+    // Конструирует элементы [size_, new_size) инициализацией по умолчанию.
+    // Если аллокатор переопределяет construct, используется он
+    constexpr void defaultConstructTail(size_type new_size) {
+        if constexpr (not detail::custom_construct<T, allocator_type>) {
+            if (not std::is_constant_evaluated()) {
+                if constexpr (not std::is_trivially_default_constructible_v<
+                                  T>) {
+                    T* ptr = std::to_address(data_);
+                    size_type i = size_;
+                    try {
+                        for (; i < new_size; ++i) {
+                            ::new (static_cast<void*>(ptr + i)) T;
+                        }
+                    } catch (...) {
+                        std::destroy(ptr + size_, ptr + i);
+                        throw;
+                    }
+                }
+                size_ = new_size;
+                return;
             }
         }
+        constructTail(new_size);
+    }
 
-        std::allocator_traits<allocator_type>::construct(
-            std::get<1>(data_), std::get<0>(data_) + size_, std::move(value));
-        ++size_;
+    // Выделяет блок не менее чем на count элементов и запоминает его
+    // реальную ёмкость
+    constexpr void allocateStorage(std::size_t count) {
+        if (count > max_size()) {
+            throw std::length_error("");
+        }
+        auto [ptr, allocated] = allocateBlock(count);
+        data_ = ptr;
+        capacity_ = allocated;
     }
 
-    template <class... Args>
-    constexpr reference emplace_back(Args&&... args) {
-        if (size_ == capacity_) {
-            if (capacity_ == 0) {
-                reallocate(1);
-            } else {
-                reallocate(capacity_ * 2);
+    // Лежит ли объект по адресу ptr среди элементов вектора. При константном
+    // вычислении указатели на разные объекты нельзя сравнивать через <,
+    // поэтому элементы перебираются
+    constexpr bool isElement(const T* ptr) const {
+        const T* first = std::to_address(data_);
+        if (std::is_constant_evaluated()) {
+            for (size_type i = 0; i < size_; ++i) {
+                if (first + i == ptr) {
+                    return true;
+                }
             }
+            return false;
         }
+        return std::less_equal<const T*>()(first, ptr) and
+               std::less<const T*>()(ptr, first + size_);
+    }
 
-        std::allocator_traits<allocator_type>::construct(
-            std::get<1>(data_), std::get<0>(data_) + size_,
-            std::forward<Args>(args)...);
-        ++size_;
-        return back();
+    // См. detail::construct_from
+    template <class Next>
+    constexpr void constructFrom(pointer destination, size_type count,
+                                 Next& next) {
+        detail::construct_from(allocator_, destination, count, next);
     }
 
-    constexpr void pop_back() {
-        --size_;
-        std::allocator_traits<allocator_type>::destroy(
-            std::get<1>(data_), std::get<0>(data_) + size_);
+    // Вставляет в позицию index count элементов из последовательных вызовов
+    // next(), перевыделяя память при необходимости
+    template <class Next>
+    constexpr iterator insertCount(size_type index, std::size_t count,
+                                   Next next) {
+        if (size_ + count > capacity_) {
+            size_type new_capacity = nextCapacity(size_ + count);
+            if (not expandInPlace(new_capacity)) {
+                insertWithGrowth(index, count, new_capacity,
+                                 [&](pointer destination) {
+                                     constructFrom(destination, count, next);
+                                 });
+                return iterator(data_ + index);
+            }
+        }
+        insertInPlace(index, count, next);
+        return iterator(data_ + index);
     }
 
-    constexpr void resize(size_type count) {
-        if (size_ == count) {
+    // Заменяет содержимое count элементами из последовательных вызовов
+    // next(). Память перевыделяется, только если её не хватает: живым
+    // элементам значения присваиваются, недостающие конструируются, лишние
+    // уничтожаются
+    template <class Next>
+    constexpr void assignCount(std::size_t count, Next next) {
+        if (count > capacity_) {
+            if (count > max_size()) {
+                throw std::length_error("");
+            }
+            auto [new_data_ptr, allocated] = allocateBlock(count);
+            try {
+                constructFrom(new_data_ptr, count, next);
+            } catch (...) {
+                deallocateBlock(new_data_ptr, allocated);
+                throw;
+            }
+            deepClear();
+            data_ = new_data_ptr;
+            capacity_ = allocated;
+            size_ = count;
             return;
         }
-        if (size_ > count) {
-            reallocate(count);
+        pointer ptr = data_;
+        size_type common = std::min(size_, count);
+        for (size_type i = 0; i < common; ++i) {
+            ptr[i] = next();
+        }
+        if (count > size_) {
+            constructFrom(ptr + size_, count - size_, next);
             size_ = count;
-            return;
+        } else {
+            destroyTail(count);
         }
-        if (count > max_size()) {
-            throw std::length_error("");
+    }
+
+    // assignCount для диапазона из count элементов, начинающегося с first.
+    // Смежные диапазоны тривиально копируемых элементов копируются memcpy
+    template <class InputIt>
+    constexpr void assignFrom(InputIt first, std::size_t count) {
+        if constexpr (std::contiguous_iterator<InputIt> and
+                      std::same_as<std::iter_value_t<InputIt>, T> and
+                      bitwise_copy) {
+            if (not std::is_constant_evaluated()) {
+                assignBitwise(std::to_address(first), count);
+                return;
+            }
+        }
+        assignCount(count,
+                    [&first]() -> decltype(auto) { return *first++; });
+    }
+
+    // Заменяет содержимое count элементами, скопированными memcpy из source,
+    // который не должен указывать внутрь вектора
+    void assignBitwise(const T* source, std::size_t count) {
+        if (count > capacity_) {
+            if (count > max_size()) {
+                throw std::length_error("");
+            }
+            deepClear();
+            allocateStorage(count);
         }
-        reallocate(count);
-        while (size_ < count) {
-            emplace_back();
+        destroyTail(std::min(size_, count));
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(data_),
+                        static_cast<const void*>(source), count * sizeof(T));
         }
+        size_ = count;
     }
 
-    constexpr void resize(size_type count, const T& value) {
-        if (size_ == count) {
-            return;
+    // Вставка count элементов, скопированных memcpy из source, который не
+    // должен указывать внутрь вектора
+    iterator insertBitwise(size_type index, const T* source,
+                           std::size_t count) {
+        auto copy = [source, count](pointer destination) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(destination),
+                            static_cast<const void*>(source),
+                            count * sizeof(T));
+            }
+        };
+        if (size_ + count > capacity_) {
+            size_type new_capacity = nextCapacity(size_ + count);
+            if (not expandInPlace(new_capacity)) {
+                insertWithGrowth(index, count, new_capacity, copy);
+                return iterator(data_ + index);
+            }
         }
-        if (size_ > count) {
-            reallocate(count);
-            size_ = count;
+        shiftRight(index, count);
+        copy(data_ + index);
+        size_ += count;
+        return iterator(data_ + index);
+    }
+
+    // Добавление в заполненный вектор. args могут ссылаться на его
+    // элементы, поэтому новый элемент создаётся раньше, чем старые
+    // переносятся и освобождаются
+    template <class... Args>
+    constexpr void growAndEmplaceBack(Args&&... args) {
+        size_type new_capacity = nextCapacity(std::size_t{size_} + 1);
+        if (expandInPlace(new_capacity)) {
+            std::allocator_traits<allocator_type>::construct(
+                allocator_, data_ + size_, std::forward<Args>(args)...);
+            ++size_;
             return;
         }
-        reallocate(count);
-        while (size_ < count) {
-            push_back(value);
+        if constexpr (reallocatable_allocator<allocator_type> and
+                      bitwise_relocation) {
+            if (data_ != nullptr and not isInline(data_)) {
+                // realloc может перенести блок: значение создаётся заранее
+                T value(std::forward<Args>(args)...);
+                reallocate(new_capacity);
+                std::allocator_traits<allocator_type>::construct(
+                    allocator_, data_ + size_, std::move(value));
+                ++size_;
+                return;
+            }
         }
+        insertWithGrowth(size_, 1, new_capacity, [&](pointer destination) {
+            std::allocator_traits<allocator_type>::construct(
+                allocator_, destination, std::forward<Args>(args)...);
+        });
     }
 
-    constexpr void swap(vector& other) noexcept(
-        std::allocator_traits<Allocator>::propagate_on_container_swap::value or
-        std::allocator_traits<Allocator>::is_always_equal::value) {
-        std::swap(capacity_, other.capacity_);
-        std::swap(size_, other.size_);
-        std::swap(std::get<0>(data_), std::get<0>(other.data_));
-        if constexpr (std::allocator_traits<
-                          allocator_type>::propagate_on_container_swap::value) {
-            using std::swap;
-            swap(std::get<1>(data_), std::get<1>(other.data_));
+    // Вставка с перевыделением: construct_new создаёт все новые элементы
+    // сразу в новом буфере (или не создаёт ни одного и бросает исключение),
+    // после чего префикс и суффикс переносятся туда за один проход
+    template <class ConstructNew>
+    constexpr void insertWithGrowth(size_type index, size_type count,
+                                    size_type new_capacity,
+                                    ConstructNew construct_new) {
+        auto [new_data_ptr, allocated] = allocateBlock(new_capacity);
+        try {
+            construct_new(new_data_ptr + index);
+        } catch (...) {
+            deallocateBlock(new_data_ptr, allocated);
+            throw;
+        }
+        pointer ptr = data_;
+        bool relocated = false;
+        if constexpr (bitwise_relocation) {
+            if (not std::is_constant_evaluated()) {
+                relocate(ptr, index, new_data_ptr);
+                relocate(ptr + index, size_ - index,
+                         new_data_ptr + index + count);
+                relocated = true;
+            }
+        }
+        if (not relocated) {
+            try {
+                // префикс и суффикс уничтожаются только после того, как оба
+                // перенесены, чтобы при исключении вектор не изменился
+                moveIfNoexcept(ptr, index, new_data_ptr);
+                try {
+                    moveIfNoexcept(ptr + index, size_ - index,
+                                   new_data_ptr + index + count);
+                } catch (...) {
+                    destroyElements(new_data_ptr, index);
+                    throw;
+                }
+            } catch (...) {
+                destroyElements(new_data_ptr + index, count);
+                deallocateBlock(new_data_ptr, allocated);
+                throw;
+            }
+            destroyElements(ptr, size_);
         }
+        deallocateBlock(ptr, capacity_);
+        data_ = new_data_ptr;
+        capacity_ = allocated;
+        size_ += count;
     }
 
-   private:
-    size_type capacity_{0};
-    size_type size_{0};
-    std::tuple<pointer, allocator_type>
-        data_;  // возможно применение EOB для пустого Allocator
-
-    void reallocate(size_t new_capacity) {
-        pointer new_data_ptr = std::allocator_traits<allocator_type>::allocate(
-            std::get<1>(data_), new_capacity);
-        size_type new_size = std::min(size_, new_capacity);
-        for (size_type i = 0; i < new_size; ++i) {
-            if constexpr (std::is_move_constructible_v<value_type>) {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), new_data_ptr + i,
-                    std::move(std::get<0>(data_)[i]));
-            } else {
-                std::allocator_traits<allocator_type>::construct(
-                    std::get<1>(data_), new_data_ptr + i,
-                    std::get<0>(data_)[i]);
+    // Вставка без перевыделения, ёмкости должно хватать. Хвост сдвигается
+    // одним memmove для тривиально перемещаемых типов и move_backward для
+    // остальных, после чего новые значения из next() записываются в
+    // освободившиеся позиции
+    template <class Next>
+    constexpr void insertInPlace(size_type index, size_type count,
+                                 Next& next) {
+        pointer ptr = data_;
+        size_type old_size = size_;
+        if constexpr (bitwise_relocation) {
+            if (not std::is_constant_evaluated()) {
+                shiftRight(index, count);
+                size_ += count;
+                try {
+                    constructFrom(ptr + index, count, next);
+                } catch (...) {
+                    shiftLeft(index + count, count);
+                    size_ -= count;
+                    throw;
+                }
+                return;
             }
         }
-        for (size_type i = 0; i < size_; ++i) {
-            std::allocator_traits<allocator_type>::destroy(
-                std::get<1>(data_), std::get<0>(data_) + i);
+        size_type tail = old_size - index;
+        if (tail > count) {
+            // последние count элементов переезжают в неинициализированную
+            // память, остальная часть хвоста сдвигается присваиванием
+            auto from_tail = [it = ptr + old_size - count]() mutable
+                -> T&& { return std::move(*it++); };
+            constructFrom(ptr + old_size, count, from_tail);
+            size_ += count;
+            std::move_backward(ptr + index, ptr + old_size - count,
+                               ptr + old_size);
+            for (size_type i = 0; i < count; ++i) {
+                ptr[index + i] = next();
+            }
+            return;
         }
-        if (std::get<0>(data_) != nullptr) {
-            std::allocator_traits<allocator_type>::deallocate(
-                std::get<1>(data_), std::get<0>(data_), capacity_);
+        // хвост целиком переезжает в неинициализированную память, новые
+        // значения частично присваиваются, частично конструируются
+        auto from_tail = [it = ptr + index]() mutable -> T&& {
+            return std::move(*it++);
+        };
+        constructFrom(ptr + index + count, tail, from_tail);
+        try {
+            for (size_type i = 0; i < tail; ++i) {
+                ptr[index + i] = next();
+            }
+            constructFrom(ptr + old_size, count - tail, next);
+        } catch (...) {
+            for (size_type i = 0; i < tail; ++i) {
+                std::allocator_traits<allocator_type>::destroy(
+                    allocator_, ptr + index + count + i);
+            }
+            throw;
         }
-        std::get<0>(data_) = new_data_ptr;
-        capacity_ = new_capacity;
-        size_ = new_size;
+        size_ += count;
+    }
+
+    // Увеличивает ёмкость через try_expand аллокатора, не перемещая
+    // элементы; возвращает false, если это невозможно
+    constexpr bool expandInPlace(size_type new_capacity) {
+        if constexpr (expandable_allocator<allocator_type>) {
+            pointer ptr = data_;
+            if (ptr != nullptr and not isInline(ptr) and
+                new_capacity > capacity_ and
+                allocator_.try_expand(ptr, capacity_, new_capacity)) {
+                capacity_ = new_capacity;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Меняет ёмкость без выделения нового блока через расширения аллокатора,
+    // возвращает false, если это невозможно
+    constexpr bool resizeInPlace(size_type new_capacity) {
+        pointer ptr = data_;
+        if (ptr == nullptr or isInline(ptr) or new_capacity == 0) {
+            return false;
+        }
+        if (expandInPlace(new_capacity)) {
+            return true;
+        }
+        if constexpr (reallocatable_allocator<allocator_type> and
+                      bitwise_relocation) {
+            destroyTail(std::min(size_, new_capacity));
+            auto [new_data, allocated] = detail::reallocate_at_least(
+                allocator_, ptr, capacity_, new_capacity);
+            data_ = new_data;
+            capacity_ = static_cast<size_type>(
+                std::min<std::size_t>(allocated, max_size()));
+            return true;
+        }
+        return false;
+    }
+
+    // Parallel: побайтово перемещаемые элементы переносятся в новый блок
+    // частями в нескольких потоках, см. parallelRelocate
+    template <bool Parallel = false>
+    constexpr void reallocate(size_type new_capacity) {
+        if (isInline(data_) and new_capacity <= InlineCapacity) {
+            destroyTail(std::min(size_, new_capacity));
+            return;
+        }
+        if (resizeInPlace(new_capacity)) {
+            return;
+        }
+        auto [new_data_ptr, allocated] = allocateBlock(new_capacity);
+        destroyTail(std::min(size_, new_capacity));
+        try {
+            if constexpr (Parallel and bitwise_relocation) {
+                parallelRelocate(new_data_ptr);
+            } else {
+                relocate(data_, size_, new_data_ptr);
+            }
+        } catch (...) {
+            deallocateBlock(new_data_ptr, allocated);
+            throw;
+        }
+        deallocateBlock(data_, capacity_);
+        data_ = new_data_ptr;
+        capacity_ = allocated;
     }
 
     constexpr void deepClear() {
         clear();
-        if (std::get<0>(data_) != nullptr) {
-            std::allocator_traits<allocator_type>::deallocate(
-                std::get<1>(data_), std::get<0>(data_), capacity_);
-            std::get<0>(data_) = nullptr;
-        }
+        deallocateBlock(data_, capacity_);
+        data_ = nullptr;
         capacity_ = 0;
     }
 };
 
-template <class T, class Allocator>
-bool operator==(const vector<T, Allocator>& lhs,
-                const vector<T, Allocator>& rhs) {
+template <class T, class Allocator, class GrowthPolicy,
+          std::size_t InlineCapacity, class SizeType>
+constexpr bool operator==(
+    const vector<T, Allocator, GrowthPolicy, InlineCapacity, SizeType>& lhs,
+    const vector<T, Allocator, GrowthPolicy, InlineCapacity, SizeType>&
+        rhs) {
     if (lhs.size() != rhs.size()) {
         return false;
     }
@@ -857,43 +1915,85 @@ bool operator==(const vector<T, Allocator>& lhs,
     return true;
 }
 
-template <class T, class Allocator>
-auto operator<=>(const vector<T, Allocator>& lhs,
-                 const vector<T, Allocator>& rhs) {
+template <class T, class Allocator, class GrowthPolicy,
+          std::size_t InlineCapacity, class SizeType>
+constexpr auto operator<=>(
+    const vector<T, Allocator, GrowthPolicy, InlineCapacity, SizeType>& lhs,
+    const vector<T, Allocator, GrowthPolicy, InlineCapacity, SizeType>&
+        rhs) {
     return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(),
                                                   rhs.begin(), rhs.end());
 }
 
-template <class T, class Allocator, class U>
-constexpr vector<T, Allocator>::size_type erase(vector<T, Allocator>& vec,
-                                                const U& value) {
+template <class T, class Allocator, class GrowthPolicy,
+          std::size_t InlineCapacity, class SizeType, class U>
+constexpr SizeType erase(
+    vector<T, Allocator, GrowthPolicy, InlineCapacity, SizeType>& vec,
+    const U& value) {
     auto it = std::remove(vec.begin(), vec.end(), value);
     auto r = vec.end() - it;
     vec.erase(it, vec.end());
     return r;
 }
 
-template <class T, class Allocator, class Pred>
-constexpr vector<T, Allocator>::size_type erase_if(vector<T, Allocator>& vec,
-                                                   Pred predicate) {
+template <class T, class Allocator, class GrowthPolicy,
+          std::size_t InlineCapacity, class SizeType, class Pred>
+constexpr SizeType erase_if(
+    vector<T, Allocator, GrowthPolicy, InlineCapacity, SizeType>& vec,
+    Pred predicate) {
     auto it = std::remove_if(vec.begin(), vec.end(), predicate);
     auto r = vec.end() - it;
     vec.erase(it, vec.end());
     return r;
 }
 
+/*
+ * Вектор, хранящий до N элементов внутри объекта без обращений к
+ * аллокатору
+ */
+template <class T, std::size_t N, class Allocator = std::allocator<T>>
+using small_vector = vector<T, Allocator, doubling_growth, N>;
+
+/*
+ * Вектор с 32-битными размером и ёмкостью: при пустых аллокаторе и
+ * стратегии роста объект занимает 16 байт вместо 24, max_size() не
+ * превышает 2^32 - 1
+ */
+template <class T, class Allocator = std::allocator<T>>
+using compact_vector = vector<T, Allocator, doubling_growth, 0, std::uint32_t>;
+
+namespace pmr {
+
+/*
+ * Вектор поверх std::pmr::memory_resource. Вложенные векторы и другие
+ * контейнеры, использующие аллокатор, получают ресурс внешнего вектора
+ * через uses-allocator construction в polymorphic_allocator::construct
+ */
+template <class T>
+using vector = my_vector::vector<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 template <class InputIt,
           class Allocator = std::allocator<
               typename std::iterator_traits<InputIt>::value_type>>
 vector(InputIt, InputIt, Allocator = Allocator())
     -> vector<typename std::iterator_traits<InputIt>::value_type, Allocator>;
+
+template <std::ranges::input_range Range,
+          class Allocator = std::allocator<std::ranges::range_value_t<Range>>>
+vector(from_range_t, Range&&, Allocator = Allocator())
+    -> vector<std::ranges::range_value_t<Range>, Allocator>;
 }  // namespace my_vector
 
 namespace std {
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy,
+          std::size_t InlineCapacity, class SizeType>
 void swap(
-    my_vector::vector<T, Allocator>& lhs,
-    my_vector::vector<T, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    my_vector::vector<T, Allocator, GrowthPolicy, InlineCapacity, SizeType>&
+        lhs,
+    my_vector::vector<T, Allocator, GrowthPolicy, InlineCapacity, SizeType>&
+        rhs) noexcept(noexcept(lhs.swap(rhs))) {
     lhs.swap(rhs);
 }
 }  // namespace std
@@ -1,8 +1,21 @@
+#include "my_allocators.h"
+#include "my_concurrent_vector.h"
+#include "my_inplace_vector.h"
+#include "my_segmented_vector.h"
+#include "my_sharded_vector.h"
+#include "my_thin_vector.h"
 #include "my_vector.h"
 #define CATCH_CONFIG_MAIN
 
 #include "catch/catch.hpp"
 
+#include <atomic>
+#include <map>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
 template <typename T>
 class TestAllocator {
    public:
@@ -41,8 +54,84 @@ bool operator!=(const TestAllocator<T>&, const TestAllocator<U>&) {
     return false;
 }
 
+// Аллокатор с состоянием, пригодный для constexpr
+template <typename T>
+struct TaggedAllocator {
+    using value_type = T;
+
+    constexpr TaggedAllocator(int tag = 0) noexcept : tag(tag) {}
+
+    template <typename U>
+    constexpr TaggedAllocator(const TaggedAllocator<U>& other) noexcept
+        : tag(other.tag) {}
+
+    constexpr T* allocate(std::size_t n) {
+        return std::allocator<T>().allocate(n);
+    }
+
+    constexpr void deallocate(T* p, std::size_t n) {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend constexpr bool operator==(const TaggedAllocator&,
+                                     const TaggedAllocator&) = default;
+
+    int tag;
+};
+
 TEST_CASE("Empty base optimization") {
     static_assert(sizeof(my_vector::vector<int>) == 3 * sizeof(int*));
+    static_assert(sizeof(my_vector::vector<int, TestAllocator<int>>) ==
+                  3 * sizeof(int*));
+    static_assert(sizeof(my_vector::compact_vector<int>) == 2 * sizeof(int*));
+    static_assert(sizeof(my_vector::vector<int, TaggedAllocator<int>>) ==
+                  4 * sizeof(int*));
+    static_assert(
+        sizeof(my_vector::compact_vector<int, TaggedAllocator<int>>) ==
+        3 * sizeof(int*));
+}
+
+template <typename Allocator>
+constexpr int constexprVectorChecksum(const Allocator& allocator) {
+    my_vector::vector<int, Allocator> v(4, allocator);
+    for (int i = 0; i < 20; ++i) {
+        v.push_back(i);
+    }
+    v.insert(v.begin() + 2, {100, 200});
+    v.erase(v.begin(), v.begin() + 4);
+    v.resize(30, 7);
+    v.shrink_to_fit();
+    v.insert(v.begin(), 5, 9);
+    v.insert(v.begin(), 2, v[1]);
+    v.erase(v.begin(), v.begin() + 7);
+    v.resize(100, 4);
+    v.resize(30);
+    v.shrink_to_fit();
+    my_vector::vector<int, Allocator> copy(v);
+    v.assign(3, 1);
+    copy.swap(v);
+    if (v.get_allocator() != allocator or v.capacity() != 30 or
+        copy.size() != 3) {
+        return -1;
+    }
+    int sum = 0;
+    for (int value : v) {
+        sum += value;
+    }
+    return sum + *v.data();
+}
+
+TEST_CASE("Vector Constant Evaluation", "[vector][constexpr]") {
+    // 0..19 и восемь семёрок
+    static_assert(constexprVectorChecksum(std::allocator<int>()) == 190 + 56);
+    static_assert(constexprVectorChecksum(TaggedAllocator<int>(5)) ==
+                  190 + 56);
+    static_assert([] {
+        my_vector::compact_vector<int> v{3, 1, 2};
+        std::ranges::sort(v);
+        return v == my_vector::compact_vector<int>{1, 2, 3};
+    }());
+    REQUIRE(constexprVectorChecksum(TaggedAllocator<int>(5)) == 246);
 }
 
 TEST_CASE("Vector Constructors", "[vector][constructor]") {
@@ -142,6 +231,50 @@ TEST_CASE("Vector Assign and Resize", "[vector][assign][resize]") {
         v1.resize(3);
         REQUIRE(v1.size() == 3);
     }
+
+    SECTION("Resize Smaller Keeps Buffer") {
+        auto shared = std::make_shared<int>(1);
+        my_vector::vector<std::shared_ptr<int>> v1(5, shared);
+        auto* old_data = v1.data();
+        v1.resize(2);
+        REQUIRE(v1.data() == old_data);
+        REQUIRE(v1.capacity() == 5);
+        REQUIRE(shared.use_count() == 3);
+    }
+
+    SECTION("Resize Larger Grows Geometrically") {
+        my_vector::vector<int> v1;
+        size_t reallocations = 0;
+        for (size_t i = 1; i <= 1000; ++i) {
+            auto* old_data = v1.data();
+            v1.resize(v1.size() + 3);
+            reallocations += v1.data() != old_data;
+        }
+        REQUIRE(v1.size() == 3000);
+        REQUIRE(reallocations <= 11);
+        REQUIRE(v1[2999] == 0);
+    }
+
+    SECTION("Resize With Own Element") {
+        my_vector::vector<int> v1{1, 2, 3};
+        v1.resize(10, v1[1]);
+        REQUIRE(v1.size() == 10);
+        REQUIRE(v1[9] == 2);
+    }
+
+    SECTION("Resize Rolls Back On Exception") {
+        static int constructed = 0;
+        struct ThrowingDefault {
+            ThrowingDefault() {
+                if (++constructed == 3) {
+                    throw std::runtime_error("");
+                }
+            }
+        };
+        my_vector::vector<ThrowingDefault> v1;
+        REQUIRE_THROWS_AS(v1.resize(5), std::runtime_error);
+        REQUIRE(v1.empty());
+    }
 }
 
 TEST_CASE("Vector Clear and Shrink to Fit", "[vector][clear][shrink_to_fit]") {
@@ -450,3 +583,1582 @@ TEST_CASE("Vector Type Requirements", "[vector][type]") {
         REQUIRE(v.size() == 2);
     }
 }
+
+struct RelocatableObject {
+    RelocatableObject(int v) : value(v) {}
+    RelocatableObject(RelocatableObject&& other) noexcept : value(other.value) {
+        ++move_count;
+    }
+    RelocatableObject& operator=(RelocatableObject&& other) noexcept {
+        value = other.value;
+        ++move_count;
+        return *this;
+    }
+    ~RelocatableObject() {}
+
+    int value;
+    static inline size_t move_count = 0;
+};
+
+template <>
+struct my_vector::is_trivially_relocatable<RelocatableObject>
+    : std::true_type {};
+
+TEST_CASE("Vector Trivial Relocation", "[vector][relocation]") {
+    static_assert(my_vector::is_trivially_relocatable_v<int>);
+    static_assert(my_vector::is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(not my_vector::is_trivially_relocatable_v<TestObject>);
+
+    SECTION("Opt-in Type Is Relocated Without Moves") {
+        RelocatableObject::move_count = 0;
+        my_vector::vector<RelocatableObject> v;
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back(i);
+        }
+        v.emplace(v.begin(), -1);
+        v.erase(v.begin() + 10, v.begin() + 20);
+        v.erase(v.begin());
+        REQUIRE(RelocatableObject::move_count == 1);
+        REQUIRE(v.size() == 90);
+        REQUIRE(v[0].value == 0);
+        REQUIRE(v[8].value == 8);
+        REQUIRE(v[9].value == 19);
+    }
+
+    SECTION("Unique Pointers") {
+        my_vector::vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < 10; ++i) {
+            v.push_back(std::make_unique<int>(i));
+        }
+        v.insert(v.begin(), std::make_unique<int>(-1));
+        v.erase(v.begin() + 5);
+        REQUIRE(v.size() == 10);
+        REQUIRE(*v[0] == -1);
+        REQUIRE(*v[4] == 3);
+        REQUIRE(*v[5] == 5);
+    }
+
+    SECTION("Non-relocatable Type Keeps Element Order") {
+        my_vector::vector<TestObject> v;
+        for (int i = 0; i < 10; ++i) {
+            v.emplace_back(i);
+        }
+        v.insert(v.begin(), TestObject(-1));
+        v.erase(v.begin() + 1, v.begin() + 3);
+        REQUIRE(v.size() == 9);
+        REQUIRE(v[0].value_ == -1);
+        REQUIRE(v[1].value_ == 2);
+        REQUIRE(v[8].value_ == 9);
+    }
+}
+
+TEST_CASE("Vector Growth Policies", "[vector][growth]") {
+    static_assert(sizeof(my_vector::vector<int, std::allocator<int>,
+                                           my_vector::one_and_half_growth>) ==
+                  3 * sizeof(int*));
+    static_assert(sizeof(my_vector::vector<int, std::allocator<int>,
+                                           my_vector::size_class_growth>) ==
+                  3 * sizeof(int*));
+
+    SECTION("Doubling") {
+        my_vector::vector<int> v;
+        v.push_back(1);
+        REQUIRE(v.capacity() == 1);
+        v.push_back(2);
+        v.push_back(3);
+        REQUIRE(v.capacity() == 4);
+    }
+
+    SECTION("One And Half") {
+        my_vector::vector<int, std::allocator<int>,
+                          my_vector::one_and_half_growth>
+            v;
+        v.reserve(10);
+        for (int i = 0; i < 11; ++i) {
+            v.push_back(i);
+        }
+        REQUIRE(v.capacity() == 15);
+        REQUIRE(v[10] == 10);
+    }
+
+    SECTION("Page Rounded") {
+        my_vector::vector<int, std::allocator<int>,
+                          my_vector::page_rounded_growth<4096>>
+            v;
+        for (int i = 0; i < 3; ++i) {
+            v.push_back(i);
+        }
+        REQUIRE(v.capacity() == 4);
+        v.reserve(1000);
+        v.insert(v.end(), 1000, 7);
+        REQUIRE(v.capacity() == 2048);
+    }
+
+    SECTION("Huge Page Rounded Beyond Threshold") {
+        constexpr std::size_t kHuge = my_vector::huge_page_size;
+        my_vector::huge_page_growth<kHuge / 2> policy;
+        REQUIRE(policy.next_capacity(1000, 1001, 4) == 2000);
+        REQUIRE(policy.next_capacity(300000, 300001, 4) == kHuge / 2);
+        REQUIRE(policy.next_capacity(kHuge / 4 + 1, kHuge / 4 + 2, 1) ==
+                kHuge);
+    }
+
+    SECTION("Size Class Rounded") {
+        using policy = my_vector::size_class_growth;
+        static_assert(policy::round_to_size_class(1) == 8);
+        static_assert(policy::round_to_size_class(17) == 32);
+        static_assert(policy::round_to_size_class(129) == 160);
+        static_assert(policy::round_to_size_class(257) == 320);
+        static_assert(policy::round_to_size_class(4097) == 5120);
+
+        my_vector::vector<char, std::allocator<char>, policy> v;
+        v.push_back('a');
+        REQUIRE(v.capacity() == 8);
+        v.reserve(129);
+        for (int i = 0; i < 129; ++i) {
+            v.push_back('b');
+        }
+        REQUIRE(v.capacity() == 320);
+    }
+}
+
+template <typename T>
+class ExpandableAllocator : public TestAllocator<T> {
+   public:
+    ExpandableAllocator() = default;
+
+    template <typename U>
+    ExpandableAllocator(const ExpandableAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t) {
+        ++allocations;
+        return static_cast<T*>(::operator new(limit * sizeof(T)));
+    }
+
+    bool try_expand(T*, std::size_t, std::size_t new_n) {
+        return new_n <= limit;
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = ExpandableAllocator<U>;
+    };
+
+    static constexpr std::size_t limit = 64;
+    static inline std::size_t allocations = 0;
+};
+
+template <typename T>
+class RoundingAllocator : public TestAllocator<T> {
+   public:
+    RoundingAllocator() = default;
+
+    template <typename U>
+    RoundingAllocator(const RoundingAllocator<U>&) noexcept {}
+
+    my_vector::allocation_result<T*> allocate_at_least(std::size_t n) {
+        std::size_t count = (n + 15) / 16 * 16;
+        return {this->allocate(count), count};
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = RoundingAllocator<U>;
+    };
+};
+
+// Округляет и блоки, которые перевыделяет reallocate
+template <typename T>
+class RoundingReallocator : public RoundingAllocator<T> {
+   public:
+    RoundingReallocator() = default;
+
+    template <typename U>
+    RoundingReallocator(const RoundingReallocator<U>&) noexcept {}
+
+    T* reallocate(T* ptr, std::size_t n, std::size_t new_n) {
+        return reallocate_at_least(ptr, n, new_n).ptr;
+    }
+
+    my_vector::allocation_result<T*> reallocate_at_least(T* ptr,
+                                                         std::size_t n,
+                                                         std::size_t new_n) {
+        auto result = this->allocate_at_least(new_n);
+        std::memcpy(result.ptr, ptr, std::min(n, new_n) * sizeof(T));
+        this->deallocate(ptr, n);
+        return result;
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = RoundingReallocator<U>;
+    };
+};
+
+TEST_CASE("Vector Allocate At Least", "[vector][allocator]") {
+    my_vector::vector<int, RoundingAllocator<int>> v;
+    v.push_back(1);
+    REQUIRE(v.capacity() == 16);
+    for (int i = 0; i < 16; ++i) {
+        v.push_back(i);
+    }
+    REQUIRE(v.capacity() == 32);
+
+    my_vector::vector<int, RoundingAllocator<int>> w(3, 7);
+    REQUIRE(w.capacity() == 16);
+
+    static_assert(
+        my_vector::reallocatable_allocator<RoundingReallocator<int>>);
+    my_vector::vector<int, RoundingReallocator<int>> r(20, 7);
+    REQUIRE(r.capacity() == 32);
+    r.resize(3);
+    r.shrink_to_fit();
+    REQUIRE(r.capacity() == 16);
+    REQUIRE(r[2] == 7);
+}
+
+TEST_CASE("Vector In-place Expansion", "[vector][allocator][expand]") {
+    static_assert(
+        my_vector::expandable_allocator<my_vector::malloc_allocator<int>>);
+    static_assert(
+        my_vector::reallocatable_allocator<my_vector::malloc_allocator<int>>);
+    static_assert(not my_vector::expandable_allocator<std::allocator<int>>);
+
+    SECTION("Try Expand") {
+        ExpandableAllocator<TestObject>::allocations = 0;
+        my_vector::vector<TestObject, ExpandableAllocator<TestObject>> v;
+        for (int i = 0; i < 64; ++i) {
+            v.emplace_back(i);
+        }
+        REQUIRE(ExpandableAllocator<TestObject>::allocations == 1);
+        REQUIRE(v.capacity() == 64);
+        REQUIRE(v[63].value_ == 63);
+    }
+
+    SECTION("Malloc Allocator") {
+        my_vector::vector<int, my_vector::malloc_allocator<int>> v;
+        for (int i = 0; i < 100000; ++i) {
+            v.push_back(i);
+        }
+        v.resize(10);
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == 10);
+        REQUIRE(v[9] == 9);
+    }
+
+    SECTION("Malloc Allocator Reports Usable Size") {
+        my_vector::vector<char, my_vector::malloc_allocator<char>> v;
+        v.push_back('a');
+        REQUIRE(v.capacity() == malloc_usable_size(v.data()));
+
+        my_vector::vector<char, my_vector::malloc_allocator<char>> copy(v);
+        REQUIRE(copy.capacity() >= v.capacity());
+
+        v.reserve(100001);
+        REQUIRE(v.capacity() == malloc_usable_size(v.data()));
+        v.resize(3);
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == malloc_usable_size(v.data()));
+        REQUIRE(v[0] == 'a');
+    }
+
+    SECTION("Malloc Allocator Try Expand Overflow") {
+        my_vector::malloc_allocator<int> allocator;
+        int* ptr = allocator.allocate(4);
+        std::size_t overflowing = std::numeric_limits<std::size_t>::max() / 2;
+        REQUIRE(allocator.try_expand(ptr, 4, 4));
+        REQUIRE_FALSE(allocator.try_expand(ptr, 4, overflowing));
+        allocator.deallocate(ptr, 4);
+    }
+
+    SECTION("Malloc Allocator With Non-trivial Type") {
+        my_vector::vector<std::unique_ptr<int>,
+                          my_vector::malloc_allocator<std::unique_ptr<int>>>
+            v;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(std::make_unique<int>(i));
+        }
+        v.resize(500);
+        v.shrink_to_fit();
+        REQUIRE(v.size() == 500);
+        REQUIRE(*v[499] == 499);
+    }
+}
+
+TEST_CASE("Vector Default Init Resize", "[vector][resize]") {
+    SECTION("Resize Default Init") {
+        my_vector::vector<int> v{1, 2, 3};
+        v.resize_default_init(1000);
+        REQUIRE(v.size() == 1000);
+        REQUIRE(v[2] == 3);
+        v.resize_default_init(2);
+        REQUIRE(v.size() == 2);
+        REQUIRE(v[1] == 2);
+    }
+
+    SECTION("Resize And Overwrite") {
+        my_vector::vector<unsigned char> v{'a'};
+        const char* payload = "payload";
+        v.resize_and_overwrite(64, [payload](unsigned char* buffer, size_t n) {
+            REQUIRE(n == 64);
+            REQUIRE(buffer[0] == 'a');
+            std::memcpy(buffer + 1, payload, 7);
+            return 8;
+        });
+        REQUIRE(v.size() == 8);
+        REQUIRE(v.capacity() >= 64);
+        REQUIRE(v[7] == 'd');
+    }
+
+    SECTION("Non-trivial Types Are Constructed") {
+        my_vector::vector<std::string> v{"kept"};
+        v.resize_and_overwrite(4, [](std::string* strings, size_t) {
+            strings[1] = "produced";
+            return 2;
+        });
+        REQUIRE(v.size() == 2);
+        REQUIRE(v[0] == "kept");
+        REQUIRE(v[1] == "produced");
+    }
+}
+
+TEST_CASE("Vector Range Insert", "[vector][insert]") {
+    SECTION("Growth Moves Each Element Once") {
+        my_vector::vector<TestObject> v;
+        v.reserve(8);
+        for (int i = 0; i < 8; ++i) {
+            v.emplace_back(i);
+        }
+        TestObject source[] = {10, 11, 12};
+        TestObject::reset_counters();
+        v.insert(v.begin() + 3, std::begin(source), std::end(source));
+        REQUIRE(TestObject::get_move_count() == 8);
+        REQUIRE(TestObject::get_copy_count() == 3);
+        REQUIRE(v.size() == 11);
+        REQUIRE(v[2].value_ == 2);
+        REQUIRE(v[3].value_ == 10);
+        REQUIRE(v[5].value_ == 12);
+        REQUIRE(v[6].value_ == 3);
+    }
+
+    SECTION("In Place With Long Tail") {
+        my_vector::vector<TestObject> v;
+        v.reserve(16);
+        for (int i = 0; i < 8; ++i) {
+            v.emplace_back(i);
+        }
+        TestObject::reset_counters();
+        v.insert(v.begin() + 1, 2, TestObject(-1));
+        REQUIRE(TestObject::get_move_count() == 7);
+        REQUIRE(v.size() == 10);
+        REQUIRE(v[0].value_ == 0);
+        REQUIRE(v[1].value_ == -1);
+        REQUIRE(v[2].value_ == -1);
+        REQUIRE(v[3].value_ == 1);
+        REQUIRE(v[9].value_ == 7);
+    }
+
+    SECTION("In Place With Short Tail") {
+        my_vector::vector<TestObject> v;
+        v.reserve(16);
+        for (int i = 0; i < 4; ++i) {
+            v.emplace_back(i);
+        }
+        v.insert(v.begin() + 3, {TestObject(7), TestObject(8), TestObject(9)});
+        REQUIRE(v.size() == 7);
+        REQUIRE(v[2].value_ == 2);
+        REQUIRE(v[3].value_ == 7);
+        REQUIRE(v[5].value_ == 9);
+        REQUIRE(v[6].value_ == 3);
+    }
+
+    SECTION("Input Iterators") {
+        std::istringstream input("4 5 6");
+        my_vector::vector<int> v{1, 2, 3};
+        v.insert(v.begin() + 1, std::istream_iterator<int>(input),
+                 std::istream_iterator<int>());
+        REQUIRE(v == my_vector::vector<int>{1, 4, 5, 6, 2, 3});
+    }
+
+    SECTION("Fill With Own Element") {
+        my_vector::vector<int> v{1, 2, 3};
+        v.reserve(10);
+        v.insert(v.begin(), 3, v[2]);
+        REQUIRE(v == my_vector::vector<int>{3, 3, 3, 1, 2, 3});
+        v.insert(v.begin(), 10, v[3]);
+        REQUIRE(v.size() == 16);
+        REQUIRE(v[9] == 1);
+    }
+
+    SECTION("Own Element At End When Full") {
+        my_vector::vector<std::string> v{"a string long enough to allocate"};
+        REQUIRE(v.size() == v.capacity());
+        v.insert(v.end(), v[0]);
+        REQUIRE(v.size() == v.capacity());
+        v.push_back(v[0]);
+        v.emplace_back(v[1]);
+        REQUIRE(v.size() == 4);
+        REQUIRE(v[3] == "a string long enough to allocate");
+
+        my_vector::vector<int, my_vector::malloc_allocator<int>> ints{5};
+        for (int i = 0; i < 20; ++i) {
+            ints.push_back(ints[0]);
+        }
+        REQUIRE(std::count(ints.begin(), ints.end(), 5) == 21);
+    }
+
+    SECTION("Strong Guarantee On Growth") {
+        struct ThrowOnCopy {
+            ThrowOnCopy(int v) : value(v) {}
+            ThrowOnCopy(const ThrowOnCopy& other) : value(other.value) {
+                if (value < 0) {
+                    throw std::runtime_error("");
+                }
+            }
+            ThrowOnCopy& operator=(const ThrowOnCopy&) = default;
+
+            int value;
+        };
+        my_vector::vector<ThrowOnCopy> v{1, 2, 3};
+        ThrowOnCopy source[] = {4, -5};
+        REQUIRE_THROWS_AS(
+            v.insert(v.begin(), std::begin(source), std::end(source)),
+            std::runtime_error);
+        REQUIRE(v.size() == 3);
+        REQUIRE(v.capacity() == 3);
+        REQUIRE(v[0].value == 1);
+    }
+}
+
+TEST_CASE("Vector Ranges", "[vector][ranges]") {
+    SECTION("From Range Constructor") {
+        auto squares = std::views::iota(1, 6) |
+                       std::views::transform([](int x) { return x * x; });
+        my_vector::vector<int> v(my_vector::from_range, squares);
+        REQUIRE(v == my_vector::vector<int>{1, 4, 9, 16, 25});
+        REQUIRE(v.capacity() == 5);
+
+        my_vector::vector deduced(my_vector::from_range,
+                                  std::views::iota(0, 3));
+        static_assert(
+            std::is_same_v<decltype(deduced), my_vector::vector<int>>);
+        REQUIRE(deduced.size() == 3);
+    }
+
+    SECTION("Append Range") {
+        my_vector::vector<int> v{1, 2};
+        int array[] = {3, 4, 5};
+        v.append_range(array);
+        v.append_range(std::views::iota(6, 8));
+        REQUIRE(v == my_vector::vector<int>{1, 2, 3, 4, 5, 6, 7});
+    }
+
+    SECTION("Insert Range") {
+        my_vector::vector<std::string> v{"a", "d"};
+        std::string middle[] = {"b", "c"};
+        auto it = v.insert_range(v.begin() + 1, middle);
+        REQUIRE(*it == "b");
+        REQUIRE(v == my_vector::vector<std::string>{"a", "b", "c", "d"});
+
+        my_vector::vector<int> w{1, 5};
+        w.reserve(10);
+        int array[] = {2, 3, 4};
+        w.insert_range(w.begin() + 1, array);
+        REQUIRE(w == my_vector::vector<int>{1, 2, 3, 4, 5});
+    }
+
+    SECTION("Input Range Without Size") {
+        std::istringstream input("3 4");
+        my_vector::vector<int> v{1, 2, 5};
+        v.insert_range(v.begin() + 2, std::views::istream<int>(input));
+        REQUIRE(v == my_vector::vector<int>{1, 2, 3, 4, 5});
+    }
+
+    SECTION("Assign Range") {
+        my_vector::vector<int> v{1, 2, 3, 4};
+        auto old_capacity = v.capacity();
+        v.assign_range(std::views::iota(10, 12));
+        REQUIRE(v == my_vector::vector<int>{10, 11});
+        REQUIRE(v.capacity() == old_capacity);
+    }
+}
+
+TEST_CASE("Vector Assignment Reuses Capacity", "[vector][assign]") {
+    SECTION("Copy Assignment") {
+        my_vector::vector<int> source{1, 2, 3};
+        my_vector::vector<int> v;
+        v.reserve(10);
+        auto* old_data = v.data();
+        v = source;
+        REQUIRE(v.data() == old_data);
+        REQUIRE(v.capacity() == 10);
+        REQUIRE(v == source);
+
+        my_vector::vector<int> larger(20, 5);
+        v = larger;
+        REQUIRE(v == larger);
+    }
+
+    SECTION("Live Elements Are Assigned") {
+        my_vector::vector<TestObject> source;
+        for (int i = 0; i < 5; ++i) {
+            source.emplace_back(i);
+        }
+        my_vector::vector<TestObject> v;
+        v.reserve(8);
+        for (int i = 0; i < 3; ++i) {
+            v.emplace_back(-i);
+        }
+        TestObject::reset_counters();
+        v = source;
+        REQUIRE(TestObject::get_copy_count() == 5);
+        REQUIRE(TestObject::get_destructor_count() == 0);
+        REQUIRE(v == source);
+
+        TestObject::reset_counters();
+        v.assign(2, TestObject(7));
+        REQUIRE(v.size() == 2);
+        REQUIRE(v[1].value_ == 7);
+        REQUIRE(TestObject::get_destructor_count() == 4);
+    }
+
+    SECTION("Assign Keeps Buffer") {
+        my_vector::vector<std::string> v(6, "long enough to be on the heap");
+        auto* old_data = v.data();
+        v.assign({"a", "b"});
+        REQUIRE(v.data() == old_data);
+        REQUIRE(v == my_vector::vector<std::string>{"a", "b"});
+        v = {"c"};
+        REQUIRE(v.data() == old_data);
+        REQUIRE(v.size() == 1);
+        v.assign(4, v[0]);
+        REQUIRE(v.data() == old_data);
+        REQUIRE(v == my_vector::vector<std::string>(4, "c"));
+    }
+
+    SECTION("Assign From Input Iterators") {
+        std::istringstream input("7 8");
+        my_vector::vector<int> v{1, 2, 3};
+        v.assign(std::istream_iterator<int>(input),
+                 std::istream_iterator<int>());
+        REQUIRE(v == my_vector::vector<int>{7, 8});
+    }
+}
+
+TEST_CASE("Vector Move If Noexcept", "[vector][move][exception]") {
+    static_assert(
+        std::is_nothrow_move_constructible_v<my_vector::vector<int>>);
+    static_assert(
+        std::is_nothrow_move_constructible_v<my_vector::vector<TestObject>>);
+
+    SECTION("Nested Vectors Are Moved On Growth") {
+        my_vector::vector<my_vector::vector<TestObject>> outer;
+        TestObject::reset_counters();
+        for (int i = 0; i < 20; ++i) {
+            outer.emplace_back(3, TestObject(i));
+        }
+        REQUIRE(TestObject::get_copy_count() == 20 * 3);
+        outer.insert(outer.begin(), my_vector::vector<TestObject>(2));
+        outer.shrink_to_fit();
+        REQUIRE(TestObject::get_copy_count() == 20 * 3);
+        REQUIRE(outer[20][2].value_ == 19);
+    }
+
+    SECTION("Nested In std::vector") {
+        std::vector<my_vector::vector<TestObject>> outer;
+        TestObject::reset_counters();
+        for (int i = 0; i < 20; ++i) {
+            outer.emplace_back(2, TestObject(i));
+        }
+        REQUIRE(TestObject::get_copy_count() == 20 * 2);
+    }
+
+    SECTION("Throwing Move Falls Back To Copy") {
+        static int copies = 0;
+        struct ThrowingMove {
+            ThrowingMove(int v) : value(v) {}
+            ThrowingMove(const ThrowingMove& other) : value(other.value) {
+                if (value == 2 and ++copies > 1) {
+                    throw std::runtime_error("");
+                }
+            }
+            ThrowingMove(ThrowingMove&& other) : value(other.value) {
+                other.value = -1;
+            }
+            ThrowingMove& operator=(const ThrowingMove&) = default;
+            int value;
+        };
+        my_vector::vector<ThrowingMove> v;
+        v.reserve(3);
+        for (int i = 0; i < 3; ++i) {
+            v.emplace_back(i);
+        }
+        REQUIRE_NOTHROW(v.reserve(6));
+        REQUIRE_THROWS_AS(v.reserve(12), std::runtime_error);
+        REQUIRE_THROWS_AS(v.shrink_to_fit(), std::runtime_error);
+        REQUIRE_THROWS_AS(v.insert(v.begin() + 1, 4, ThrowingMove(7)),
+                          std::runtime_error);
+        REQUIRE(v.capacity() == 6);
+        REQUIRE(v.size() == 3);
+        REQUIRE(v[0].value == 0);
+        REQUIRE(v[1].value == 1);
+        REQUIRE(v[2].value == 2);
+    }
+}
+
+template <typename T>
+class CountingAllocator : public TestAllocator<T> {
+   public:
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        ++allocations;
+        return TestAllocator<T>::allocate(n);
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = CountingAllocator<U>;
+    };
+
+    static inline std::size_t allocations = 0;
+};
+
+// Стратегия роста с состоянием: каждый экземпляр получает свой номер
+struct NumberedGrowth {
+    static inline int next = 0;
+    int number = next++;
+
+    std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                              std::size_t) const {
+        return std::max(capacity * 2, required);
+    }
+};
+
+// Аллокатор с состоянием, которое передаётся при swap; считает блоки,
+// освобождённые не тем аллокатором, который их выделил
+template <typename T>
+struct SwappedAllocator {
+    using value_type = T;
+    using propagate_on_container_swap = std::true_type;
+
+    static inline std::map<const void*, int> owners;
+    static inline int mismatches = 0;
+
+    SwappedAllocator(int tag = 0) noexcept : tag(tag) {}
+
+    template <typename U>
+    SwappedAllocator(const SwappedAllocator<U>& other) noexcept
+        : tag(other.tag) {}
+
+    T* allocate(std::size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        owners[p] = tag;
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        mismatches += owners[p] != tag;
+        owners.erase(p);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend bool operator==(const SwappedAllocator&,
+                           const SwappedAllocator&) = default;
+
+    int tag;
+};
+
+struct ThrowingMove {
+    ThrowingMove() = default;
+    ThrowingMove(ThrowingMove&&) noexcept(false) {}
+    ThrowingMove& operator=(ThrowingMove&&) noexcept(false) { return *this; }
+};
+
+TEST_CASE("Small Vector", "[small_vector]") {
+    using small = my_vector::small_vector<int, 8, CountingAllocator<int>>;
+    static_assert(sizeof(small) == 3 * sizeof(int*) + 8 * sizeof(int));
+
+    SECTION("Inline Storage") {
+        CountingAllocator<int>::allocations = 0;
+        small v;
+        for (int i = 0; i < 8; ++i) {
+            v.push_back(i);
+        }
+        REQUIRE(CountingAllocator<int>::allocations == 0);
+        REQUIRE(v.capacity() == 8);
+        auto* address = reinterpret_cast<const char*>(v.data());
+        REQUIRE(address >= reinterpret_cast<const char*>(&v));
+        REQUIRE(address < reinterpret_cast<const char*>(&v + 1));
+
+        v.insert(v.begin() + 2, 100);
+        REQUIRE(CountingAllocator<int>::allocations == 1);
+        REQUIRE(v.size() == 9);
+        REQUIRE(v[2] == 100);
+        REQUIRE(v[8] == 7);
+
+        v.erase(v.begin(), v.begin() + 4);
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == 8);
+        REQUIRE(v == small{3, 4, 5, 6, 7});
+    }
+
+    SECTION("Move And Swap") {
+        my_vector::small_vector<TestObject, 4> inline_vector;
+        inline_vector.emplace_back(1);
+        inline_vector.emplace_back(2);
+        my_vector::small_vector<TestObject, 4> moved(std::move(inline_vector));
+        REQUIRE(inline_vector.empty());
+        REQUIRE(moved.size() == 2);
+        REQUIRE(moved[1].value_ == 2);
+
+        my_vector::small_vector<TestObject, 4> heap_vector;
+        for (int i = 0; i < 6; ++i) {
+            heap_vector.emplace_back(10 + i);
+        }
+        moved.swap(heap_vector);
+        REQUIRE(moved.size() == 6);
+        REQUIRE(moved[5].value_ == 15);
+        REQUIRE(heap_vector.size() == 2);
+        REQUIRE(heap_vector[0].value_ == 1);
+
+        heap_vector = std::move(moved);
+        REQUIRE(heap_vector.size() == 6);
+        moved = heap_vector;
+        REQUIRE(moved == heap_vector);
+    }
+
+    SECTION("Inline Swap Exchanges Growth Policies") {
+        using numbered = my_vector::vector<int, std::allocator<int>,
+                                           NumberedGrowth, 4>;
+        numbered first{1, 2};
+        numbered second{3, 4, 5, 6, 7};
+        int first_number = first.get_growth_policy().number;
+        int second_number = second.get_growth_policy().number;
+        first.swap(second);
+        REQUIRE(first.get_growth_policy().number == second_number);
+        REQUIRE(second.get_growth_policy().number == first_number);
+        REQUIRE(first.size() == 5);
+        REQUIRE(second == numbered{1, 2});
+    }
+
+    SECTION("Inline Swap Exchanges Allocators") {
+        using swapped = my_vector::vector<int, SwappedAllocator<int>,
+                                          my_vector::doubling_growth, 2>;
+        SwappedAllocator<int>::mismatches = 0;
+        {
+            swapped inline_vector{SwappedAllocator<int>(1)};
+            inline_vector.push_back(1);
+            swapped heap_vector{SwappedAllocator<int>(2)};
+            for (int i = 0; i < 5; ++i) {
+                heap_vector.push_back(i);
+            }
+            inline_vector.swap(heap_vector);
+            REQUIRE(inline_vector.get_allocator().tag == 2);
+            REQUIRE(heap_vector.get_allocator().tag == 1);
+            REQUIRE(inline_vector.size() == 5);
+            REQUIRE(heap_vector.front() == 1);
+        }
+        REQUIRE(SwappedAllocator<int>::mismatches == 0);
+    }
+
+    SECTION("Move Assignment Noexcept") {
+        static_assert(std::is_nothrow_move_assignable_v<
+                      my_vector::small_vector<int, 4>>);
+        static_assert(not std::is_nothrow_move_assignable_v<
+                      my_vector::small_vector<ThrowingMove, 4>>);
+        static_assert(std::is_nothrow_move_assignable_v<
+                      my_vector::vector<ThrowingMove>>);
+    }
+}
+
+constexpr my_vector::inplace_vector<int, 8> squares() {
+    my_vector::inplace_vector<int, 8> table;
+    for (int i = 0; table.try_push_back(i * i) != nullptr; ++i) {
+    }
+    return table;
+}
+
+TEST_CASE("Inplace Vector", "[inplace_vector]") {
+    using ints = my_vector::inplace_vector<int, 4>;
+    static_assert(std::is_trivially_copyable_v<ints>);
+    static_assert(not std::is_trivially_copyable_v<
+                  my_vector::inplace_vector<std::string, 4>>);
+    static_assert(std::ranges::contiguous_range<ints>);
+    static_assert(sizeof(my_vector::inplace_vector<char, 0>) ==
+                  sizeof(std::size_t));
+    static_assert(sizeof(my_vector::inplace_vector<std::string, 0>) ==
+                  sizeof(std::size_t));
+
+    SECTION("Constexpr") {
+        constexpr auto table = squares();
+        static_assert(table.size() == 8);
+        static_assert(table[7] == 49);
+        static_assert(ints{1, 2, 3} < ints{1, 3});
+        REQUIRE(table.back() == 49);
+    }
+
+    SECTION("Capacity Limits") {
+        ints v{1, 2, 3};
+        REQUIRE(v.try_push_back(4) != nullptr);
+        REQUIRE(v.try_push_back(5) == nullptr);
+        REQUIRE_THROWS_AS(v.push_back(5), std::bad_alloc);
+        REQUIRE_THROWS_AS(v.reserve(5), std::bad_alloc);
+        REQUIRE(v == ints{1, 2, 3, 4});
+
+        v.pop_back();
+        v.unchecked_push_back(10);
+        REQUIRE(v.back() == 10);
+
+        std::vector<int> source{7, 8, 9};
+        v.resize(2);
+        auto rest = v.try_append_range(source);
+        REQUIRE(*rest == 9);
+        REQUIRE(v == ints{1, 2, 7, 8});
+    }
+
+    SECTION("Zero Capacity") {
+        my_vector::inplace_vector<std::string, 0> empty;
+        REQUIRE(empty.empty());
+        REQUIRE(empty.try_push_back("x") == nullptr);
+        REQUIRE_THROWS_AS(empty.push_back("x"), std::bad_alloc);
+        my_vector::inplace_vector<std::string, 0> copy(empty);
+        REQUIRE(copy == empty);
+    }
+
+    SECTION("Modifiers") {
+        my_vector::inplace_vector<std::string, 6> v{"b", "d"};
+        v.insert(v.begin(), "a");
+        v.emplace(v.begin() + 2, "c");
+        v.insert(v.end(), 2, "e");
+        REQUIRE(v.size() == 6);
+        REQUIRE(v[2] == "c");
+        REQUIRE(v[5] == "e");
+
+        v.erase(v.begin() + 1, v.begin() + 3);
+        REQUIRE(v.size() == 4);
+        REQUIRE(v[1] == "d");
+
+        my_vector::inplace_vector<std::string, 6> other{"x"};
+        v.swap(other);
+        REQUIRE(v.size() == 1);
+        REQUIRE(other.size() == 4);
+        REQUIRE(other[0] == "a");
+
+        other = v;
+        REQUIRE(other == v);
+        v.clear();
+        REQUIRE(v.empty());
+    }
+}
+
+TEST_CASE("Compact Vector", "[compact_vector]") {
+    SECTION("Basic Operations") {
+        my_vector::compact_vector<int> v{1, 2, 3};
+        v.insert(v.begin(), {-1, 0});
+        v.resize(10, 7);
+        REQUIRE(v.size() == 10);
+        REQUIRE(v[0] == -1);
+        REQUIRE(v[9] == 7);
+        REQUIRE(my_vector::erase(v, 7) == 5);
+        REQUIRE(v == my_vector::compact_vector<int>{-1, 0, 1, 2, 3});
+    }
+
+    SECTION("Size Overflow") {
+        my_vector::compact_vector<char> v;
+        REQUIRE(v.max_size() == std::numeric_limits<std::uint32_t>::max());
+        REQUIRE_THROWS_AS(v.reserve(std::size_t{1} << 32), std::length_error);
+
+        using tiny = my_vector::vector<char, std::allocator<char>,
+                                       my_vector::doubling_growth, 0,
+                                       std::uint8_t>;
+        tiny t;
+        for (int i = 0; i < 255; ++i) {
+            t.push_back(static_cast<char>(i));
+        }
+        REQUIRE(t.capacity() == 255);
+        REQUIRE_THROWS_AS(t.push_back(0), std::length_error);
+        REQUIRE_THROWS_AS(t.insert(t.begin(), {'a', 'b'}), std::length_error);
+        REQUIRE_THROWS_AS(tiny(300, 'x'), std::length_error);
+        REQUIRE(t.size() == 255);
+    }
+}
+
+TEST_CASE("Thin Vector", "[thin_vector]") {
+    static_assert(sizeof(my_vector::thin_vector<int>) == sizeof(int*));
+
+    SECTION("Empty Vector Does Not Allocate") {
+        my_vector::thin_vector<int> v;
+        REQUIRE(v.data() == nullptr);
+        REQUIRE(v.capacity() == 0);
+        v.push_back(1);
+        v.pop_back();
+        v.shrink_to_fit();
+        REQUIRE(v.data() == nullptr);
+    }
+
+    SECTION("Modifiers") {
+        my_vector::thin_vector<std::string> v{"b", "d"};
+        v.insert(v.begin(), "a");
+        v.emplace(v.begin() + 2, "c");
+        v.resize(6, v[0]);
+        REQUIRE(v.size() == 6);
+        REQUIRE(v.capacity() >= 6);
+        REQUIRE(v[2] == "c");
+        REQUIRE(v[5] == "a");
+
+        v.erase(v.begin() + 1, v.begin() + 3);
+        REQUIRE(v == my_vector::thin_vector<std::string>{"a", "d", "a", "a"});
+
+        my_vector::thin_vector<std::string> copy(v);
+        my_vector::thin_vector<std::string> moved(std::move(v));
+        REQUIRE(v.data() == nullptr);
+        REQUIRE(moved == copy);
+        copy = {"x"};
+        moved.swap(copy);
+        REQUIRE(moved.size() == 1);
+        REQUIRE(copy.size() == 4);
+    }
+
+    SECTION("Over-aligned Elements") {
+        struct alignas(64) Wide {
+            int value;
+        };
+        my_vector::thin_vector<Wide> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(Wide{i});
+        }
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0);
+        REQUIRE(v[99].value == 99);
+    }
+
+    SECTION("Growth Moves Elements") {
+        my_vector::thin_vector<TestObject> v;
+        v.reserve(2);
+        v.emplace_back(1);
+        v.emplace_back(2);
+        TestObject::reset_counters();
+        v.emplace_back(3);
+        REQUIRE(TestObject::get_copy_count() == 0);
+        REQUIRE(TestObject::get_move_count() == 2);
+        REQUIRE(TestObject::get_destructor_count() == 2);
+        REQUIRE(v[2].value_ == 3);
+    }
+
+    SECTION("Own Element When Full") {
+        my_vector::thin_vector<std::string> v{
+            "a string long enough to allocate"};
+        REQUIRE(v.size() == v.capacity());
+        v.push_back(v[0]);
+        v.emplace_back(v[1]);
+        REQUIRE(v.size() == 3);
+        REQUIRE(v[2] == "a string long enough to allocate");
+    }
+
+    SECTION("Count Constructor Rolls Back") {
+        // копирование бросает исключение, когда заканчивается budget
+        struct LimitedCopies {
+            explicit LimitedCopies(int* budget) : budget(budget) {}
+            LimitedCopies(const LimitedCopies& other) : budget(other.budget) {
+                if ((*budget)-- == 0) {
+                    throw std::runtime_error("");
+                }
+            }
+            LimitedCopies& operator=(const LimitedCopies&) = default;
+
+            int* budget;
+            std::string payload = "a string long enough to allocate";
+        };
+        int budget = 5;
+        LimitedCopies value(&budget);
+        REQUIRE_THROWS_AS(my_vector::thin_vector<LimitedCopies>(10, value),
+                          std::runtime_error);
+    }
+
+    SECTION("Copy And Move Keep Growth Policy") {
+        using numbered =
+            my_vector::thin_vector<int, std::allocator<int>, NumberedGrowth>;
+        numbered v{1, 2, 3};
+        int number = v.get_growth_policy().number;
+        numbered copy(v);
+        REQUIRE(copy.get_growth_policy().number == number);
+        numbered moved(std::move(v));
+        REQUIRE(moved.get_growth_policy().number == number);
+        REQUIRE(moved == copy);
+    }
+}
+
+TEST_CASE("Segmented Vector", "[segmented_vector]") {
+    static_assert(std::random_access_iterator<
+                  my_vector::segmented_vector<int>::iterator>);
+    static_assert(std::random_access_iterator<
+                  my_vector::segmented_vector<int>::const_iterator>);
+
+    SECTION("Indexing Across Segments") {
+        my_vector::segmented_vector<int, std::allocator<int>, 4> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+        REQUIRE(v.size() == 1000);
+        REQUIRE(v.capacity() == 1020);  // 4 + 8 + ... + 512
+        bool indexed = true;
+        for (int i = 0; i < 1000; ++i) {
+            indexed = indexed and v[i] == i;
+        }
+        REQUIRE(indexed);
+        REQUIRE(std::accumulate(v.cbegin(), v.cend(), 0) == 499500);
+        REQUIRE(*(v.end() - 1) == 999);
+        REQUIRE(v.rbegin()[3] == 996);
+    }
+
+    SECTION("Stable Addresses") {
+        my_vector::segmented_vector<TestObject> v;
+        v.emplace_back(1);
+        TestObject* first = &v[0];
+        TestObject::reset_counters();
+        for (int i = 0; i < 10000; ++i) {
+            v.emplace_back(i);
+        }
+        REQUIRE(&v[0] == first);
+        REQUIRE(first->value_ == 1);
+        REQUIRE(TestObject::get_copy_count() == 0);
+        REQUIRE(TestObject::get_move_count() == 0);
+        REQUIRE(v.capacity() < 2 * v.size() + 16);
+    }
+
+    SECTION("Resize, Copy And Shrink") {
+        my_vector::segmented_vector<std::string> v{"a", "b"};
+        v.resize(100, "c");
+        my_vector::segmented_vector<std::string> copy(v);
+        REQUIRE(copy == v);
+        v.resize(10);
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == 16);
+        REQUIRE(v.back() == "c");
+        REQUIRE(v < copy);
+
+        copy = std::move(v);
+        REQUIRE(copy.size() == 10);
+        REQUIRE(v.empty());
+    }
+}
+
+TEST_CASE("Concurrent Vector", "[concurrent_vector]") {
+    SECTION("Concurrent Push Back") {
+        constexpr int kThreads = 8;
+        constexpr int kPerThread = 20000;
+        my_vector::concurrent_vector<long, std::allocator<long>, 4> v;
+        std::atomic<int> overwritten{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&v, &overwritten, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    std::size_t index = v.push_back(t * kPerThread + i);
+                    if (v[index] != t * kPerThread + i) {
+                        ++overwritten;
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(overwritten == 0);
+        REQUIRE(v.size() == kThreads * kPerThread);
+        std::vector<long> values(v.begin(), v.end());
+        std::sort(values.begin(), values.end());
+        bool all_present = true;
+        for (long i = 0; i < kThreads * kPerThread; ++i) {
+            all_present = all_present and values[i] == i;
+        }
+        REQUIRE(all_present);
+    }
+
+    SECTION("Grow By And Stable Addresses") {
+        my_vector::concurrent_vector<std::string> v;
+        v.push_back("first");
+        const std::string* first = &v[0];
+        std::size_t start = v.grow_by(1000, "x");
+        REQUIRE(start == 1);
+        REQUIRE(v.size() == 1001);
+        REQUIRE(&v[0] == first);
+        REQUIRE(v[1000] == "x");
+        REQUIRE(v.grow_by(2) == 1001);
+        REQUIRE(v.at(1002).empty());
+        REQUIRE_THROWS_AS(v.at(1003), std::out_of_range);
+        v.clear();
+        REQUIRE(v.empty());
+    }
+
+    SECTION("Throwing Constructor Leaves Default Element") {
+        struct Throwing {
+            Throwing() = default;
+            Throwing(int value) : value(value) {
+                if (value < 0) {
+                    throw std::runtime_error("");
+                }
+            }
+            int value = 0;
+        };
+        my_vector::concurrent_vector<Throwing> v;
+        REQUIRE_THROWS_AS(v.emplace_back(-1), std::runtime_error);
+        v.emplace_back(5);
+        REQUIRE(v.size() == 2);
+        REQUIRE(v[0].value == 0);
+        REQUIRE(v[1].value == 5);
+    }
+}
+
+TEST_CASE("Sharded Vector", "[sharded_vector]") {
+    SECTION("Parallel Append And Flatten") {
+        constexpr std::size_t kShards = 4;
+        constexpr std::size_t kPerShard = 50000;
+        my_vector::sharded_vector<std::size_t> v(kShards);
+        for (std::size_t i = 0; i < kShards; ++i) {
+            auto address = reinterpret_cast<std::uintptr_t>(&v.shard(i));
+            REQUIRE(address % my_vector::cache_line_size == 0);
+        }
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < kShards; ++t) {
+            threads.emplace_back([&v, t] {
+                for (std::size_t i = 0; i < kPerShard; ++i) {
+                    v.shard(t).push_back(t * kPerShard + i);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(v.size() == kShards * kPerShard);
+
+        my_vector::vector<std::size_t> flat = v.flatten();
+        REQUIRE(v.empty());
+        REQUIRE(flat.size() == kShards * kPerShard);
+        bool ordered = true;
+        for (std::size_t i = 0; i < flat.size(); ++i) {
+            ordered = ordered and flat[i] == i;
+        }
+        REQUIRE(ordered);
+    }
+
+    SECTION("Merge Appends To Existing Vector") {
+        my_vector::sharded_vector<std::string> v(3);
+        v.shard(0).push_back("a");
+        v.shard(2).push_back("c");
+        v.shard(2).push_back("d");
+        my_vector::vector<std::string> destination{"x"};
+        v.merge(destination);
+        REQUIRE(destination ==
+                my_vector::vector<std::string>{"x", "a", "c", "d"});
+        REQUIRE(v.empty());
+        REQUIRE(v.shard(2).capacity() >= 2);
+    }
+
+    SECTION("Merge Rolls Back When A Copy Throws") {
+        struct Tagged {
+            explicit Tagged(int v) : value(v) {}
+            Tagged(const Tagged& other) : value(other.value) {
+                if (value < 0) {
+                    throw std::runtime_error("");
+                }
+            }
+            Tagged& operator=(const Tagged&) = default;
+
+            int value;
+            std::string payload = "a string long enough to allocate";
+        };
+        my_vector::sharded_vector<Tagged> v(2);
+        v.shard(0).emplace_back(1);
+        v.shard(0).emplace_back(2);
+        v.shard(1).emplace_back(3);
+        v.shard(1).emplace_back(-4);
+        my_vector::vector<Tagged> destination;
+        destination.emplace_back(0);
+        REQUIRE_THROWS_AS(v.merge(destination), std::runtime_error);
+        REQUIRE(destination.size() == 1);
+        REQUIRE(v.shard(0).size() == 2);
+        REQUIRE(v.shard(1)[1].value == -4);
+
+        v.shard(1).pop_back();
+        v.merge(destination);
+        REQUIRE(destination.size() == 4);
+        REQUIRE(destination[3].value == 3);
+        REQUIRE(v.empty());
+    }
+}
+
+// Считает живые объекты; копирование с номером throw_at бросает исключение
+struct Counted {
+    static inline std::atomic<int> live = 0;
+    static inline std::atomic<std::size_t> copies = 0;
+    static inline std::size_t throw_at = 0;
+
+    Counted() { ++live; }
+    Counted(const Counted&) {
+        if (++copies == throw_at) {
+            throw std::runtime_error("");
+        }
+        ++live;
+    }
+    ~Counted() { --live; }
+
+    std::size_t value = 0;
+};
+
+TEST_CASE("Vector Parallel Fill", "[vector][parallel]") {
+    constexpr std::size_t kCount = 1 << 20;
+
+    SECTION("Constructors") {
+        my_vector::vector<int> zeros(my_vector::parallel, kCount);
+        my_vector::vector<int> sevens(my_vector::parallel, kCount, 7);
+        REQUIRE(zeros.size() == kCount);
+        REQUIRE(sevens.size() == kCount);
+        REQUIRE(std::count(zeros.begin(), zeros.end(), 0) == kCount);
+        REQUIRE(std::count(sevens.begin(), sevens.end(), 7) == kCount);
+        sevens.reserve(my_vector::parallel, 2 * kCount);
+        REQUIRE(sevens.capacity() >= 2 * kCount);
+        REQUIRE(std::count(sevens.begin(), sevens.end(), 7) == kCount);
+    }
+
+    SECTION("Resize And Assign") {
+        my_vector::vector<std::string> v{"first"};
+        v.resize(my_vector::parallel, kCount / 8, v[0]);
+        REQUIRE(v.size() == kCount / 8);
+        REQUIRE(std::count(v.begin(), v.end(), "first") == kCount / 8);
+        v.assign(my_vector::parallel, kCount / 16, "second");
+        REQUIRE(v.size() == kCount / 16);
+        REQUIRE(v.back() == "second");
+        v.assign(my_vector::parallel, kCount / 4, v[0]);
+        REQUIRE(std::count(v.begin(), v.end(), "second") == kCount / 4);
+    }
+
+    SECTION("Exception Rolls Back") {
+        Counted::copies = 0;
+        Counted::throw_at = 3 * kCount / 4;
+        {
+            my_vector::vector<Counted> v(3);
+            Counted value;
+            REQUIRE_THROWS_AS(v.resize(my_vector::parallel, kCount, value),
+                              std::runtime_error);
+            REQUIRE(v.size() == 3);
+            REQUIRE(Counted::live == 4);
+            Counted::copies = 0;
+            REQUIRE_THROWS_AS(
+                my_vector::vector<Counted>(my_vector::parallel, kCount, value),
+                std::runtime_error);
+        }
+        REQUIRE(Counted::live == 0);
+    }
+}
+
+TEST_CASE("NUMA Allocator", "[vector][allocator][numa]") {
+    using Allocator = my_vector::numa_allocator<long>;
+    static_assert(my_vector::expandable_allocator<Allocator>);
+    static_assert(my_vector::reallocatable_allocator<Allocator>);
+    REQUIRE(Allocator::node_count() >= 1);
+
+    SECTION("Placements") {
+        for (my_vector::numa_placement placement :
+             {my_vector::numa_placement::local,
+              my_vector::numa_placement::interleave,
+              my_vector::numa_placement::bind}) {
+            my_vector::vector<long, Allocator> v{Allocator(placement)};
+            for (long i = 0; i < 100000; ++i) {
+                v.push_back(i);
+            }
+            REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) %
+                        sysconf(_SC_PAGESIZE) ==
+                    0);
+            REQUIRE(std::accumulate(v.begin(), v.end(), 0l) ==
+                    100000l * 99999 / 2);
+            my_vector::vector<long, Allocator> copy(v);
+            REQUIRE(copy.get_allocator().placement() == placement);
+        }
+    }
+
+    SECTION("Parallel Fill And Relocation") {
+        my_vector::vector<long, Allocator> v{
+            Allocator(my_vector::numa_placement::local)};
+        v.push_back(-1);
+        v.resize(my_vector::parallel, 1 << 20, 3);
+        v.reserve(my_vector::parallel, 1 << 21);
+        REQUIRE(v.capacity() >= 1 << 21);
+        REQUIRE(v.front() == -1);
+        REQUIRE(std::count(v.begin(), v.end(), 3) == (1 << 20) - 1);
+    }
+
+    SECTION("Empty Vectors") {
+        Allocator allocator(my_vector::numa_placement::interleave);
+        my_vector::vector<long, Allocator> empty{allocator};
+        my_vector::vector<long, Allocator> copy(empty);
+        REQUIRE(copy.empty());
+        my_vector::vector<long, Allocator> none(0, 7, allocator);
+        REQUIRE(none.capacity() == 0);
+
+        my_vector::vector<long, Allocator> v(1000, 7, allocator);
+        v.clear();
+        v.shrink_to_fit();
+        REQUIRE(v.capacity() == 0);
+        REQUIRE(v.data() == nullptr);
+        v.push_back(1);
+        REQUIRE(v.front() == 1);
+    }
+}
+
+TEST_CASE("Monotonic Allocator", "[vector][allocator][arena]") {
+    using Allocator = my_vector::monotonic_allocator<int>;
+    static_assert(my_vector::expandable_allocator<Allocator>);
+
+    SECTION("Last Allocation Grows In Place") {
+        my_vector::arena arena(1 << 20);
+        my_vector::vector<int, Allocator> v{Allocator(arena)};
+        v.push_back(0);
+        const int* data = v.data();
+        for (int i = 1; i < 100000; ++i) {
+            v.push_back(i);
+        }
+        REQUIRE(v.data() == data);
+        REQUIRE(v[99999] == 99999);
+    }
+
+    SECTION("Interleaved Vectors And Release") {
+        using StringAllocator = my_vector::monotonic_allocator<std::string>;
+        my_vector::arena arena(256);
+        {
+            my_vector::vector<std::string, StringAllocator> strings{
+                StringAllocator(arena)};
+            my_vector::vector<int, Allocator> numbers{Allocator(arena)};
+            for (int i = 0; i < 1000; ++i) {
+                strings.push_back(std::to_string(i));
+                numbers.push_back(i);
+            }
+            REQUIRE(strings[999] == "999");
+            REQUIRE(std::accumulate(numbers.begin(), numbers.end(), 0) ==
+                    1000 * 999 / 2);
+        }
+        arena.release();
+
+        my_vector::vector<int, Allocator> reused{Allocator(arena)};
+        reused.resize(1000, 7);
+        REQUIRE(reused.back() == 7);
+    }
+
+    SECTION("Empty Allocation Does Not Alias The Next One") {
+        my_vector::arena arena;
+        my_vector::vector<int, Allocator> empty(0, Allocator(arena));
+        my_vector::vector<int, Allocator> other(4, 42, Allocator(arena));
+        empty.push_back(7);
+        my_vector::vector<int, Allocator> copy(empty);
+        copy.push_back(8);
+        REQUIRE(other == my_vector::vector<int, Allocator>(4, 42,
+                                                           Allocator(arena)));
+        REQUIRE(empty[0] == 7);
+    }
+
+    SECTION("Allocators Compare By Arena") {
+        my_vector::arena first;
+        my_vector::arena second;
+        REQUIRE(Allocator(first) ==
+                my_vector::monotonic_allocator<char>(first));
+        REQUIRE(Allocator(first) != Allocator(second));
+        my_vector::vector<int, Allocator> lhs({1, 2, 3}, Allocator(first));
+        my_vector::vector<int, Allocator> rhs{Allocator(second)};
+        rhs = std::move(lhs);
+        REQUIRE(rhs.get_allocator() == Allocator(second));
+        REQUIRE(rhs == my_vector::vector<int, Allocator>({1, 2, 3},
+                                                         Allocator(first)));
+    }
+}
+
+TEST_CASE("PMR Vector", "[vector][allocator][pmr]") {
+    using IntVector = my_vector::pmr::vector<int>;
+    static_assert(
+        my_vector::detail::bitwise_relocation<int, IntVector::allocator_type>);
+    static_assert(
+        std::uses_allocator_v<IntVector, IntVector::allocator_type>);
+
+    SECTION("Monotonic Buffer Resource") {
+        std::byte buffer[4096];
+        std::pmr::monotonic_buffer_resource resource(
+            buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        IntVector v(&resource);
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i);
+        }
+        auto* data = reinterpret_cast<std::byte*>(v.data());
+        REQUIRE(data >= buffer);
+        REQUIRE(data < buffer + sizeof(buffer));
+        REQUIRE(v[99] == 99);
+    }
+
+    SECTION("Nested Vectors Share The Outer Resource") {
+        std::pmr::unsynchronized_pool_resource pool;
+        my_vector::pmr::vector<IntVector> outer(&pool);
+        outer.emplace_back();
+        outer.back().push_back(1);
+        outer.emplace_back(3, 7);
+        IntVector foreign{1, 2, 3};
+        outer.push_back(foreign);
+        outer.push_back(std::move(foreign));
+        for (int i = 0; i < 100; ++i) {
+            outer.emplace_back(i);
+        }
+        REQUIRE(outer[1] == IntVector{7, 7, 7});
+        REQUIRE(outer[3] == IntVector{1, 2, 3});
+        bool shared = true;
+        for (const IntVector& inner : outer) {
+            shared = shared and inner.get_allocator().resource() == &pool;
+        }
+        REQUIRE(shared);
+    }
+
+    SECTION("Non-propagating Assignment") {
+        std::pmr::unsynchronized_pool_resource first;
+        std::pmr::monotonic_buffer_resource second;
+        IntVector source({1, 2, 3}, &first);
+        IntVector target({4}, &second);
+
+        target = source;
+        REQUIRE(target == source);
+        REQUIRE(target.get_allocator().resource() == &second);
+
+        target = std::move(source);
+        REQUIRE(target == IntVector{1, 2, 3});
+        REQUIRE(target.get_allocator().resource() == &second);
+
+        IntVector same({5, 6}, &second);
+        const int* data = same.data();
+        target = std::move(same);
+        REQUIRE(target.data() == data);
+    }
+
+    SECTION("Move With Allocator") {
+        std::pmr::unsynchronized_pool_resource first;
+        std::pmr::unsynchronized_pool_resource second;
+        my_vector::pmr::vector<std::pmr::string> source(&first);
+        source.emplace_back("a string long enough to be allocated");
+        my_vector::pmr::vector<std::pmr::string> moved(std::move(source),
+                                                       &second);
+        REQUIRE(moved[0] == "a string long enough to be allocated");
+        REQUIRE(moved[0].get_allocator().resource() == &second);
+
+        const std::pmr::string* data = moved.data();
+        my_vector::pmr::vector<std::pmr::string> stolen(std::move(moved),
+                                                        &second);
+        REQUIRE(stolen.data() == data);
+    }
+}
+
+TEST_CASE("Pooled Allocator", "[vector][allocator][pool]") {
+    using Vector = my_vector::vector<int, my_vector::pooled_allocator<int>>;
+    my_vector::buffer_pool& pool = *my_vector::buffer_pool::local();
+    pool.trim();
+
+    SECTION("Buffers Are Recycled") {
+        const int* data = nullptr;
+        {
+            Vector v(100, 1);
+            REQUIRE(v.capacity() == 128);
+            data = v.data();
+        }
+        std::size_t hits = pool.stats().hits;
+        Vector v;
+        v.resize(120);
+        REQUIRE(v.data() == data);
+        REQUIRE(pool.stats().hits == hits + 1);
+    }
+
+    SECTION("Limits") {
+        std::size_t limit = pool.max_cached_bytes();
+        pool.set_max_cached_bytes(4096);
+        std::size_t dropped = pool.stats().dropped;
+        {
+            Vector small(500);
+            Vector large(5000);
+        }
+        REQUIRE(pool.stats().cached_bytes == 2048);
+        REQUIRE(pool.stats().dropped == dropped + 1);
+
+        {
+            Vector huge(my_vector::buffer_pool::max_block);
+        }
+        REQUIRE(pool.stats().cached_bytes == 2048);
+        pool.set_max_cached_bytes(limit);
+    }
+
+    SECTION("Pools Are Per Thread") {
+        std::size_t misses = 0;
+        std::thread([&misses] {
+            Vector v{1, 2, 3};
+            misses = my_vector::buffer_pool::local()->stats().misses;
+        }).join();
+        REQUIRE(misses == 1);
+    }
+}
+
+TEST_CASE("Huge Page Allocator", "[vector][allocator][huge_page]") {
+    using Allocator = my_vector::huge_page_allocator<float>;
+    constexpr std::size_t kHuge = my_vector::huge_page_size;
+    static_assert(my_vector::expandable_allocator<Allocator>);
+
+    SECTION("Large Blocks Are Huge Page Aligned") {
+        my_vector::vector<float, Allocator, my_vector::huge_page_growth<>> v;
+        for (std::size_t i = 0; i < kHuge; ++i) {
+            v.push_back(static_cast<float>(i % 1024));
+        }
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) % kHuge == 0);
+        REQUIRE(v.capacity() * sizeof(float) % kHuge == 0);
+        REQUIRE(v[kHuge - 1] == 1023.0f);
+        v.shrink_to_fit();
+        REQUIRE(v.size() == kHuge);
+    }
+
+    SECTION("Small Blocks") {
+        my_vector::vector<float, Allocator> v{1.0f, 2.0f};
+        v.resize(1000, 3.0f);
+        REQUIRE(v.capacity() < kHuge / sizeof(float));
+        REQUIRE(v.back() == 3.0f);
+    }
+}
+
+TEST_CASE("Aligned Allocator", "[vector][allocator][aligned]") {
+    using Allocator = my_vector::aligned_allocator<float>;
+    static_assert(
+        std::is_same_v<std::allocator_traits<Allocator>::rebind_alloc<double>,
+                       my_vector::aligned_allocator<double>>);
+    static_assert(Allocator::padded_size(17) == 32);
+    static_assert(Allocator::padded_size(32) == 32);
+
+    SECTION("Data Is Aligned And Capacity Padded") {
+        my_vector::vector<float, Allocator> v;
+        bool aligned = true;
+        bool padded = true;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(static_cast<float>(i));
+            aligned = aligned and
+                      reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0;
+            padded = padded and v.capacity() % 16 == 0;
+        }
+        REQUIRE(aligned);
+        REQUIRE(padded);
+        REQUIRE(v.capacity() >= Allocator::padded_size(v.size()));
+    }
+
+    SECTION("Standard Containers") {
+        std::vector<float, Allocator> v(3, 1.0f);
+        v.resize(100, 2.0f);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0);
+        REQUIRE(v[99] == 2.0f);
+    }
+
+    SECTION("Without Padding") {
+        using Unpadded = my_vector::aligned_allocator<double, 128, false>;
+        my_vector::vector<double, Unpadded> v;
+        v.reserve(3);
+        REQUIRE(v.capacity() == 3);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) % 128 == 0);
+    }
+}